@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+
+#include "blockio.hpp"
+#include "control_data.hpp"
+#include "decls.hpp"
+
+namespace wbtree::detail {
+struct BackupResult {
+  u64 pages_scanned;
+  u64 pages_copied;
+  u64 pages_torn;    // copied, although still torn after re-reading them
+  LogSeqNum max_lsn; // newest page LSN seen
+};
+
+// WAL segments, [first, last], needed to make a backup consistent
+struct WALRange {
+  WALSegNum first;
+  WALSegNum last;
+};
+
+// Copies the pages of relation file `src` whose LSN is newer than `since`, or all of them if
+// `since` is empty, to `dst` while the database keeps running. `src` is read with a PageScanner.
+// Copied pages are written at their own offset, and skipped pages are left as holes, which never
+// pass page verification, so a restore can tell them apart.
+//
+// Pages may be modified while they are read, so the backup is consistent only together with the
+// WAL returned by BackupWALRange(). `start_redo` is the RedoLSN() of its `start` control data. A
+// page failing verification is read again a few times. If it still fails, and its LSN is at least
+// `start_redo`, it is being modified and is copied anyway, for the WAL replay to rewrite.
+// Otherwise error::CorruptPage is thrown, for full backups too.
+auto BackupRelation(blockio::IOMethods &io, const std::filesystem::path &src,
+                    const std::filesystem::path &dst, usize page_size, LogSeqNum start_redo,
+                    Option<LogSeqNum> since) -> BackupResult;
+
+// `start` must be the control data read before the first relation was copied, and `end` the one
+// read after the last. The `start.RedoLSN()` is the `since` for the next incremental backup.
+[[nodiscard]] auto BackupWALRange(const ControlData &start, const ControlData &end) -> WALRange;
+} // namespace wbtree::detail
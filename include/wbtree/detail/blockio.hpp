@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cerrno>
 #include <gsl/span>
 #include <stdexcept>
+#include <utility>
 
 #include "wbtree/common/inttypes.hpp"
 #include "wbtree/common/strong_integer.hpp"
@@ -35,6 +37,39 @@ struct IOException : std::system_error {
   explicit IOException(error::errno_t errn) : std::system_error(errn, std::generic_category()) {}
 };
 
+// Class of an IO request, in decreasing order of latency sensitivity. Threads outside any
+// IOPriorityScope issue FOREGROUND_READ, of which only reads are treated as foreground.
+enum class IOPriority : unsigned {
+  FOREGROUND_READ,
+  WAL_FLUSH,
+  BACKGROUND_READ,
+  BACKGROUND_WRITE,
+  CHECKPOINT,
+  LAST
+};
+
+namespace detail {
+inline thread_local IOPriority current_io_priority = IOPriority::FOREGROUND_READ;
+} // namespace detail
+
+[[nodiscard]] inline auto CurrentIOPriority() -> IOPriority { return detail::current_io_priority; }
+
+// Tags all IO issued by the calling thread within the scope with `prio`
+class IOPriorityScope {
+public:
+  explicit IOPriorityScope(IOPriority prio)
+      : m_saved(std::exchange(detail::current_io_priority, prio)) {}
+  ~IOPriorityScope() { detail::current_io_priority = m_saved; }
+
+  IOPriorityScope(const IOPriorityScope &) = delete;
+  IOPriorityScope(IOPriorityScope &&) = delete;
+  auto operator=(const IOPriorityScope &) -> IOPriorityScope & = delete;
+  auto operator=(IOPriorityScope &&) -> IOPriorityScope & = delete;
+
+private:
+  IOPriority m_saved;
+};
+
 struct IOMethods {
   virtual ~IOMethods() = default;
 
@@ -172,4 +207,29 @@ inline auto Open(std::string_view path, u32 flags, u32 mode = 0) -> FileDesc {
 
 inline auto Tell(const FileDesc &fd) { return fd.Seek(0, Whence::CUR); }
 
+// Opens `path` with O_DIRECT, falling back to buffered IO where the file system does not support it
+inline auto OpenDirectWith(IOMethods &io, std::string_view path, u32 flags, u32 mode = 0)
+    -> FileDesc {
+  try {
+    return OpenWith(io, path, flags | OpenFlags::DIRECT, mode);
+  } catch (const IOException &e) {
+    if (e.code().value() != EINVAL)
+      throw;
+  }
+  return OpenWith(io, path, flags, mode);
+}
+
+// Reads exactly `size` bytes at `off`, retrying short reads
+inline void ReadFully(const FileDesc &fd, void *buf, usize size, isize off) {
+  usize done = 0;
+
+  while (done < size) {
+    auto readsize = fd.Read(static_cast<std::byte *>(buf) + done, size - done,
+                            off + static_cast<isize>(done));
+    if (readsize <= 0)
+      throw error::BlockIO("unexpected end of file at offset {}", off + static_cast<isize>(done));
+    done += static_cast<usize>(readsize);
+  }
+}
+
 } // namespace wbtree::blockio
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include "blockio.hpp"
+#include "decls.hpp"
+
+namespace wbtree::detail {
+struct CompactionPlan {
+  // Runs of adjacent leaves, in key order, that fit into a single page. Each run is merged into its
+  // first leaf and the rest of its leaves are freed.
+  std::vector<std::vector<PageNum>> merges;
+  // (from, to) relocations laying the surviving leaves out contiguously, in key order
+  std::vector<std::pair<PageNum, PageNum>> moves;
+  u64 pages_freed = 0;
+};
+
+// Plans the compaction of the leaves of relation file `path`, by following the leaves' right
+// sibling links. Adjacent leaves are merged while their combined payload stays within `max_fill` of
+// a page, and the survivors are relocated into the first extent of free pages large enough to hold
+// them all, or past the end of the file, unless they are already laid out contiguously. Throws
+// error::CorruptPage, if a page still fails verification after re-reading it, or if the leaves do
+// not form a single chain.
+auto PlanCompaction(blockio::IOMethods &io, const std::filesystem::path &path, usize page_size,
+                    double max_fill = 0.9) -> CompactionPlan;
+} // namespace wbtree::detail
@@ -20,6 +20,8 @@ public:
   explicit ControlData(u64 page_size) : m_page_size(page_size) {}
 
   [[nodiscard]] constexpr auto PageSize() const { return m_page_size; }
+  // Values larger than this are stored out of line in overflow pages
+  [[nodiscard]] constexpr auto MaxInlineValueSize() const { return m_page_size / 4; }
   [[nodiscard]] constexpr auto RedoLSN() const { return m_redo_lsn; }
   [[nodiscard]] constexpr auto NextOid() const { return m_next_oid; }
   [[nodiscard]] constexpr auto CurrentWALSegment() const { return m_cur_wal_seg; }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "wbtree/common/inttypes.hpp"
+
+namespace wbtree::detail {
+// Epoch based memory reclamation. Threads announce the global epoch while they access a shared
+// structure, and objects unlinked from it wait in per thread limbo lists. An object retired in
+// epoch `e` is freed once the global epoch reaches `e + 2`, since by then no thread can still be
+// in an epoch that observed it.
+class EpochManager {
+  struct Retired {
+    void *ptr;
+    void (*deleter)(void *);
+    u64 epoch;
+  };
+
+  struct ThreadRecord {
+    alignas(64) std::atomic<u64> epoch{QUIESCENT};
+    std::atomic<bool> in_use{true};
+    usize pin_depth = 0;
+    std::vector<Retired> limbo;
+  };
+
+public:
+  // Number of objects a thread retires before it tries to advance the epoch and free its limbo
+  static constexpr usize RECLAIM_BATCH = 64;
+
+  EpochManager() = default;
+  ~EpochManager();
+
+  EpochManager(const EpochManager &) = delete;
+  EpochManager(EpochManager &&) = delete;
+  auto operator=(const EpochManager &) -> EpochManager & = delete;
+  auto operator=(EpochManager &&) -> EpochManager & = delete;
+
+  class Participant;
+
+  // Pins the participant's thread to the current epoch for the guard's lifetime
+  class Guard {
+  public:
+    ~Guard();
+
+    Guard(const Guard &) = delete;
+    Guard(Guard &&) = delete;
+    auto operator=(const Guard &) -> Guard & = delete;
+    auto operator=(Guard &&) -> Guard & = delete;
+
+  private:
+    friend class Participant;
+    Guard(EpochManager &mgr, ThreadRecord &rec);
+
+    ThreadRecord &m_rec;
+  };
+
+  // Handle of a thread registered with the manager. Must not be shared among threads.
+  class Participant {
+  public:
+    ~Participant();
+
+    Participant(const Participant &) = delete;
+    Participant(Participant &&o) noexcept;
+    auto operator=(const Participant &) -> Participant & = delete;
+    auto operator=(Participant &&) -> Participant & = delete;
+
+    [[nodiscard]] auto Pin() -> Guard { return Guard(*m_mgr, *m_rec); }
+
+    // Defers `deleter(ptr)` until no thread can hold a reference to `ptr`
+    void Retire(void *ptr, void (*deleter)(void *));
+
+    template <typename T> void Retire(T *ptr) {
+      Retire(static_cast<void *>(ptr), [](void *p) { delete static_cast<T *>(p); });
+    }
+
+    // Tries to advance the epoch and frees whatever the participant retired that is now safe
+    void Reclaim();
+
+  private:
+    friend class EpochManager;
+    Participant(EpochManager &mgr, ThreadRecord &rec) : m_mgr(&mgr), m_rec(&rec) {}
+
+    EpochManager *m_mgr;
+    ThreadRecord *m_rec;
+  };
+
+  [[nodiscard]] auto Register() -> Participant;
+
+  [[nodiscard]] auto CurrentEpoch() const -> u64 {
+    return m_global_epoch.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr u64 QUIESCENT = std::numeric_limits<u64>::max();
+
+  void try_advance();
+  void unregister(ThreadRecord &rec);
+  // Removes the entries of `limbo` that no thread can reference anymore, and returns them
+  [[nodiscard]] auto take_safe(std::vector<Retired> &limbo) const -> std::vector<Retired>;
+  static void run_deleters(std::vector<Retired> batch);
+
+  alignas(64) std::atomic<u64> m_global_epoch{0};
+  std::mutex m_lock; // protects m_records and m_orphans
+  std::vector<std::unique_ptr<ThreadRecord>> m_records;
+  std::vector<Retired> m_orphans; // limbo of participants that have exited
+};
+} // namespace wbtree::detail
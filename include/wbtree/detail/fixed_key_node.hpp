@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <cstdint>
+#include <cstring>
+#include <gsl/span>
+#include <type_traits>
+
+#include "decls.hpp"
+#include "page.hpp"
+
+namespace wbtree::detail {
+// Composite key, ordered by `first`, then `second`. Unlike std::pair it is trivially copyable, so
+// that FixedKeyNode can move it around as plain bytes.
+template <typename First, typename Second> struct KeyPair {
+  First first;
+  Second second;
+
+  friend constexpr auto operator<(const KeyPair &a, const KeyPair &b) -> bool {
+    return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+  }
+  friend constexpr auto operator==(const KeyPair &a, const KeyPair &b) -> bool {
+    return a.first == b.first && a.second == b.second;
+  }
+  friend constexpr auto operator!=(const KeyPair &a, const KeyPair &b) -> bool {
+    return !(a == b);
+  }
+};
+
+template <typename Key, typename = void> struct IsFixedWidthKey : std::false_type {};
+
+template <typename Key>
+struct IsFixedWidthKey<Key, std::enable_if_t<std::is_integral_v<Key>>> : std::true_type {};
+
+template <typename Int, typename Tag>
+struct IsFixedWidthKey<Strong<Int, Tag>, std::enable_if_t<std::is_integral_v<Int>>>
+    : std::true_type {};
+
+template <typename First, typename Second>
+struct IsFixedWidthKey<KeyPair<First, Second>,
+                       std::enable_if_t<IsFixedWidthKey<First>::value &&
+                                        IsFixedWidthKey<Second>::value>> : std::true_type {};
+
+template <typename Key> static constexpr bool IS_FIXED_WIDTH_KEY = IsFixedWidthKey<Key>::value;
+
+// Returns the first position in sorted [keys, keys + n) whose key is not less than `key`. The loop
+// has a trip count that depends only on `n`, and the compiler turns its body into conditional
+// moves, so there are no mispredicted branches during the search.
+template <typename Key>
+[[nodiscard]] constexpr auto BranchlessLowerBound(const Key *keys, usize n, const Key &key)
+    -> usize {
+  const auto *base = keys;
+
+  while (n > 1) {
+    auto half = n / 2;
+    base += (base[half - 1] < key) ? half : 0;
+    n -= half;
+  }
+
+  return static_cast<usize>(base - keys) + (n == 1 && *base < key ? 1 : 0);
+}
+
+// Node layout specialized for fixed width keys: a dense, sorted key array followed by a parallel
+// value array, with no slot indirection. All sizes are computed at compile time from the key and
+// value types, and the capacity from the page size.
+template <typename Key, typename Value> class FixedKeyNode {
+  static_assert(IS_FIXED_WIDTH_KEY<Key>, "FixedKeyNode requires a fixed width integer key");
+  static_assert(std::is_trivially_copyable_v<Key>, "Key must be trivially copyable");
+  static_assert(std::is_trivially_copyable_v<Value>, "Value must be trivially copyable");
+
+public:
+  [[nodiscard]] static constexpr auto Capacity(usize page_size) -> usize {
+    auto payload = PagePayloadSize(page_size);
+    if (payload <= KEYS_OFF + alignof(Value))
+      return 0;
+    return (payload - KEYS_OFF - alignof(Value)) / ENTRY_SIZE;
+  }
+
+  template <usize PageSize> static constexpr usize CAPACITY = Capacity(PageSize);
+
+  // `payload` is the page area following the PageHeader
+  FixedKeyNode(gsl::span<std::byte> payload, usize page_size)
+      : m_payload(payload), m_capacity(Capacity(page_size)) {
+    BOOST_ASSERT(static_cast<usize>(payload.size()) >= PagePayloadSize(page_size));
+    // values_off() is aligned relative to the payload, so the payload must suit both arrays
+    BOOST_ASSERT(reinterpret_cast<uintptr_t>(payload.data()) %
+                     std::max(alignof(Key), alignof(Value)) ==
+                 0);
+  }
+
+  static auto Init(gsl::span<std::byte> payload, usize page_size) -> FixedKeyNode {
+    FixedKeyNode node(payload, page_size);
+    node.set_count(0);
+    return node;
+  }
+
+  [[nodiscard]] auto Count() const -> usize {
+    u32 count;
+    std::memcpy(&count, m_payload.data(), sizeof(count));
+    return count;
+  }
+  [[nodiscard]] auto Capacity() const -> usize { return m_capacity; }
+  [[nodiscard]] auto IsFull() const -> bool { return Count() == m_capacity; }
+
+  [[nodiscard]] auto KeyAt(usize pos) const -> const Key & { return keys()[pos]; }
+  [[nodiscard]] auto ValueAt(usize pos) const -> const Value & { return values()[pos]; }
+
+  [[nodiscard]] auto LowerBound(const Key &key) const -> usize {
+    return BranchlessLowerBound(keys(), Count(), key);
+  }
+
+  [[nodiscard]] auto Find(const Key &key) const -> Option<Value> {
+    auto pos = LowerBound(key);
+    if (pos < Count() && !(key < keys()[pos]))
+      return values()[pos];
+    return None;
+  }
+
+  // Returns false, if the node is full and must be split first
+  auto Insert(const Key &key, const Value &value) -> bool {
+    auto count = Count();
+    auto pos = LowerBound(key);
+
+    if (pos < count && !(key < keys()[pos])) {
+      values()[pos] = value;
+      return true;
+    }
+    if (count == m_capacity)
+      return false;
+
+    std::copy_backward(keys() + pos, keys() + count, keys() + count + 1);
+    std::copy_backward(values() + pos, values() + count, values() + count + 1);
+    keys()[pos] = key;
+    values()[pos] = value;
+    set_count(count + 1);
+    return true;
+  }
+
+  void RemoveAt(usize pos) {
+    auto count = Count();
+    BOOST_ASSERT(pos < count);
+
+    std::copy(keys() + pos + 1, keys() + count, keys() + pos);
+    std::copy(values() + pos + 1, values() + count, values() + pos);
+    set_count(count - 1);
+  }
+
+private:
+  static constexpr usize ENTRY_SIZE = sizeof(Key) + sizeof(Value);
+  static constexpr usize KEYS_OFF = (sizeof(u32) + alignof(Key) - 1) / alignof(Key) * alignof(Key);
+
+  [[nodiscard]] auto values_off() const -> usize {
+    auto off = KEYS_OFF + m_capacity * sizeof(Key);
+    return (off + alignof(Value) - 1) / alignof(Value) * alignof(Value);
+  }
+
+  [[nodiscard]] auto keys() const -> Key * {
+    return reinterpret_cast<Key *>(m_payload.data() + KEYS_OFF);
+  }
+  [[nodiscard]] auto values() const -> Value * {
+    return reinterpret_cast<Value *>(m_payload.data() + values_off());
+  }
+
+  void set_count(usize count) {
+    auto cnt = static_cast<u32>(count);
+    std::memcpy(m_payload.data(), &cnt, sizeof(cnt));
+  }
+
+  gsl::span<std::byte> m_payload;
+  usize m_capacity;
+};
+} // namespace wbtree::detail
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "wbtree/common/inttypes.hpp"
+
+namespace wbtree::detail {
+static constexpr usize HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Anonymous memory mapping, backed by 2 MB huge pages when the system has them reserved, and by
+// regular (transparent huge page advised) pages otherwise.
+class MappedRegion {
+public:
+  MappedRegion() = default;
+  // Prefers memory local to `numa_node`, if it is non-negative
+  MappedRegion(usize size, int numa_node);
+  ~MappedRegion();
+
+  MappedRegion(const MappedRegion &) = delete;
+  MappedRegion(MappedRegion &&o) noexcept;
+  auto operator=(const MappedRegion &) -> MappedRegion & = delete;
+  auto operator=(MappedRegion &&o) noexcept -> MappedRegion &;
+
+  [[nodiscard]] auto Data() const -> std::byte * { return m_data; }
+  [[nodiscard]] auto Size() const -> usize { return m_size; }
+  [[nodiscard]] auto IsHugePage() const -> bool { return m_huge; }
+
+private:
+  std::byte *m_data = nullptr;
+  usize m_size = 0;
+  bool m_huge = false;
+};
+
+// Ids of the NUMA nodes that have memory, in ascending order. Ids may be sparse.
+[[nodiscard]] auto MemoryNumaNodes() -> const std::vector<int> &;
+[[nodiscard]] auto CurrentNumaNode() -> int;
+
+// Buffer pool frames and their descriptors, split into one partition per NUMA node. Each
+// partition is allocated on its own node and runs its own clock sweep. On a single node system
+// this collapses to one partition.
+class FrameMemory {
+public:
+  FrameMemory(usize nframes, usize frame_size, usize desc_size);
+
+  [[nodiscard]] auto NumFrames() const -> usize { return m_nframes; }
+  [[nodiscard]] auto NumPartitions() const -> usize { return m_partitions.size(); }
+
+  // Partition whose frames are local to the calling thread
+  [[nodiscard]] auto LocalPartition() const -> usize;
+  [[nodiscard]] auto PartitionNode(usize part) const -> int { return m_partitions[part]->node; }
+  // Range of frame numbers [first, first + count) belonging to `part`
+  [[nodiscard]] auto PartitionFrames(usize part) const -> std::pair<usize, usize>;
+
+  [[nodiscard]] auto Frame(usize frameno) const -> std::byte *;
+  [[nodiscard]] auto Descriptor(usize frameno) const -> std::byte *;
+
+  // Advances the clock hand of `part` and returns the frame it points to
+  auto ClockTick(usize part) -> usize;
+
+private:
+  struct Partition {
+    MappedRegion frames;
+    MappedRegion descs;
+    int node;
+    usize first;
+    usize count;
+    alignas(64) std::atomic<usize> clock_hand{0};
+  };
+
+  [[nodiscard]] auto partition_of(usize frameno) const -> const Partition &;
+
+  usize m_nframes;
+  usize m_frame_size;
+  usize m_desc_size;
+  std::vector<std::unique_ptr<Partition>> m_partitions;
+  std::vector<usize> m_node_partition; // indexed by NUMA node id
+};
+} // namespace wbtree::detail
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "blockio.hpp"
+
+namespace wbtree::blockio {
+struct IOSchedulerConfig {
+  // Requests of a background class allowed in flight while foreground reads are waiting
+  u32 background_read_queue_depth = 2;
+  u32 background_write_queue_depth = 2;
+  u32 checkpoint_queue_depth = 1;
+  // Bytes per second a background class may transfer while foreground reads are waiting
+  u64 background_read_bandwidth = 64 * 1024 * 1024;
+  u64 background_write_bandwidth = 64 * 1024 * 1024;
+  u64 checkpoint_bandwidth = 32 * 1024 * 1024;
+};
+
+// IOMethods decorator, which throttles the background classes (BACKGROUND_READ, BACKGROUND_WRITE
+// and CHECKPOINT) in queue depth and bandwidth whenever foreground reads are waiting on the device,
+// or have been until recently. Only reads of class FOREGROUND_READ count as foreground, so that
+// untagged writes and syncs do not throttle the background. Foreground IO and WAL flushes are never
+// delayed. Priority is taken from the issuing thread's IOPriorityScope.
+class ScheduledIO : public IOMethods {
+public:
+  explicit ScheduledIO(IOMethods &io, IOSchedulerConfig config = {});
+
+  [[nodiscard]] auto Open(std::string_view path, u32 flags, u32 mode) -> fd_t override;
+  void Close(fd_t fd) override;
+
+  [[nodiscard]] auto Seek(fd_t fd, isize off, Whence whence) -> isize override;
+
+  [[nodiscard]] auto Write(fd_t fd, const void *buf, usize size) -> isize override;
+  [[nodiscard]] auto Write(fd_t fd, const void *buf, usize size, isize off) -> isize override;
+  [[nodiscard]] auto Read(fd_t fd, void *buf, usize size) -> isize override;
+  [[nodiscard]] auto Read(fd_t fd, void *buf, usize size, isize off) -> isize override;
+
+  void Sync(fd_t fd) override;
+  void DataSync(fd_t fd) override;
+  void Truncate(fd_t fd, isize off) override;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr auto NUM_CLASSES = static_cast<usize>(IOPriority::LAST);
+
+  struct ClassState {
+    u32 queue_depth = 0;
+    u64 bandwidth = 0;
+    u32 inflight = 0;
+    i64 budget = 0; // bytes left in the current refill window
+    Clock::time_point refilled{};
+  };
+
+  // Keeps a request admitted for its lifetime
+  class Ticket {
+  public:
+    Ticket(ScheduledIO &sched, usize bytes, bool read);
+    ~Ticket();
+
+    Ticket(const Ticket &) = delete;
+    Ticket(Ticket &&) = delete;
+    auto operator=(const Ticket &) -> Ticket & = delete;
+    auto operator=(Ticket &&) -> Ticket & = delete;
+
+  private:
+    ScheduledIO &m_sched;
+    IOPriority m_prio;
+    bool m_foreground;
+  };
+
+  [[nodiscard]] static constexpr auto is_background(IOPriority prio) -> bool {
+    return prio == IOPriority::BACKGROUND_READ || prio == IOPriority::BACKGROUND_WRITE ||
+           prio == IOPriority::CHECKPOINT;
+  }
+
+  void admit(IOPriority prio, usize bytes, bool foreground);
+  void release(IOPriority prio, bool foreground);
+  void refill(ClassState &cls, Clock::time_point now) const;
+
+  IOMethods &m_io;
+  std::mutex m_lock;
+  std::condition_variable m_cv;
+  u32 m_foreground_waiting = 0;
+  Clock::time_point m_foreground_done{};
+  std::array<ClassState, NUM_CLASSES> m_classes{};
+};
+} // namespace wbtree::blockio
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <gsl/span>
+#include <vector>
+
+#include "decls.hpp"
+
+namespace wbtree::detail {
+enum class MessageKind : u8 { INSERT, UPDATE, DELETE };
+
+// A message pending delivery to the leaves of a write buffered (B-epsilon) inner node.
+struct Message {
+  MessageKind kind;
+  gsl::span<const std::byte> key;
+  gsl::span<const std::byte> value; // empty for DELETE
+};
+
+// View over the region of an inner node page reserved for buffered messages. Messages are
+// appended in arrival order and delivered to the children in batches once the buffer fills.
+// Keys are compared bytewise.
+class MessageBuffer {
+public:
+  // Fraction of an inner node page given to the message buffer (1 / RESERVE_RATIO).
+  static constexpr usize RESERVE_RATIO = 2;
+
+  [[nodiscard]] static constexpr auto ReservedBytes(usize page_size) -> usize {
+    return page_size / RESERVE_RATIO;
+  }
+
+  explicit MessageBuffer(gsl::span<std::byte> region);
+
+  // Formats an empty message buffer in `region`
+  static auto Init(gsl::span<std::byte> region) -> MessageBuffer;
+
+  [[nodiscard]] auto Count() const -> usize;
+  [[nodiscard]] auto FreeSpace() const -> usize;
+  [[nodiscard]] auto Fits(gsl::span<const std::byte> key, gsl::span<const std::byte> value) const
+      -> bool;
+
+  // Returns false, if the buffer must be flushed before `msg` can be accepted.
+  // Throws error::ElementTooBig, if `msg` would not fit even in an empty buffer.
+  auto Append(const Message &msg) -> bool;
+
+  // Returns the latest pending message for `key`, which a reader must apply on top of whatever it
+  // finds further down the tree.
+  [[nodiscard]] auto Lookup(gsl::span<const std::byte> key) const -> Option<Message>;
+
+  // Invokes `sink` for every buffered message in key order. Messages of the same key are delivered
+  // in arrival order, so that the child applies them in the order they were issued.
+  template <typename Sink> void ForEachSorted(Sink &&sink) const {
+    for (auto off : sorted_offsets())
+      sink(message_at(off));
+  }
+
+  void Clear();
+
+private:
+  struct Header {
+    u32 count;
+    u32 used;
+  };
+
+  struct MessageHeader {
+    MessageKind kind;
+    u8 reserved;
+    u16 key_len;
+    u32 value_len;
+  };
+
+  [[nodiscard]] static constexpr auto message_size(usize key_len, usize value_len) -> usize {
+    return sizeof(MessageHeader) + key_len + value_len;
+  }
+
+  [[nodiscard]] auto header() const -> Header;
+  void set_header(const Header &hdr);
+  [[nodiscard]] auto message_at(usize off) const -> Message;
+  [[nodiscard]] auto sorted_offsets() const -> std::vector<usize>;
+
+  gsl::span<std::byte> m_region;
+};
+} // namespace wbtree::detail
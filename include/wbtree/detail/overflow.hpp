@@ -0,0 +1,50 @@
+#pragma once
+
+#include <gsl/span>
+#include <vector>
+
+#include "blockio.hpp"
+#include "decls.hpp"
+
+namespace wbtree::detail {
+// Leaf-resident reference to a value stored out of line in an extent of contiguous overflow pages
+struct OverflowRef {
+  PageNum first;
+  u64 length;
+};
+
+static_assert(std::is_trivially_copyable_v<OverflowRef>, "overflow ref must be memcpy'able");
+
+[[nodiscard]] auto OverflowPageCount(usize page_size, u64 length) -> u64;
+
+// Writes `value` to `OverflowPageCount()` contiguous pages of `file` starting at `first`, which the
+// caller must have reserved. Each page is chained to the next, so that the extent can be verified
+// when read back.
+auto WriteOverflow(const blockio::FileDesc &file, usize page_size, PageNum first, LogSeqNum lsn,
+                   gsl::span<const std::byte> value) -> OverflowRef;
+
+// Streams an out of line value back, one page at a time, so that large values need not be
+// materialized in a single allocation.
+class OverflowReader {
+public:
+  OverflowReader(const blockio::FileDesc &file, usize page_size, OverflowRef ref);
+
+  [[nodiscard]] auto Remaining() const -> u64 { return m_ref.length - m_consumed; }
+
+  // Copies up to `out.size()` bytes of the value to `out` and returns the number of bytes copied,
+  // which is 0 once the value is exhausted. Throws error::CorruptPage on a damaged chain.
+  auto Read(gsl::span<std::byte> out) -> usize;
+
+private:
+  void load_next_page();
+
+  const blockio::FileDesc &m_file;
+  usize m_page_size;
+  OverflowRef m_ref;
+  PageNum m_next;
+  u64 m_consumed = 0;
+  std::vector<std::byte> m_page;
+  usize m_page_used = 0;
+  usize m_page_pos = 0;
+};
+} // namespace wbtree::detail
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <gsl/span>
+#include <limits>
+#include <type_traits>
+
+#include "blockio.hpp"
+#include "decls.hpp"
+
+namespace wbtree::detail {
+enum class PageKind : u8 { FREE, INNER, LEAF, OVERFLOW, LAST };
+
+// Common header at the start of every relation page
+struct PageHeader {
+  LogSeqNum lsn; // LSN of the last WAL record that modified the page
+  u32 checksum;  // crc32c of the page, computed with this field as zero
+  PageKind kind;
+  u8 level; // 0 for leaves
+  u16 flags;
+  u32 used; // bytes of payload in use, excluding the header
+  u32 reserved;
+  PageNum next; // right sibling or next page of an overflow chain
+};
+
+static_assert(std::is_trivially_copyable_v<PageHeader>, "page header must be memcpy'able");
+static_assert(std::is_standard_layout_v<PageHeader>, "page header must be in standard layout");
+
+// Times a page failing verification is read again before it is considered corrupt
+static constexpr usize TORN_READ_RETRIES = 3;
+
+// Page numbers are below 2^63, which leaves the most significant bit free to tag swizzled child
+// pointers (see SwizzledPtr). The largest of them is reserved to mean "no page".
+static constexpr auto INVALID_PAGE = PageNum(std::numeric_limits<u64>::max() >> 1);
+
+[[nodiscard]] constexpr auto PagePayloadSize(usize page_size) -> usize {
+  return page_size - sizeof(PageHeader);
+}
+
+[[nodiscard]] constexpr auto PageOffset(PageNum pageno, usize page_size) -> isize {
+  return static_cast<isize>(pageno.get() * page_size);
+}
+
+[[nodiscard]] auto ReadPageHeader(gsl::span<const std::byte> page) -> PageHeader;
+void WritePageHeader(gsl::span<std::byte> page, const PageHeader &hdr);
+
+[[nodiscard]] auto PageChecksum(gsl::span<const std::byte> page) -> u32;
+void SetPageChecksum(gsl::span<std::byte> page);
+
+// Throws error::CorruptPage, if the stored checksum of `pageno` does not match its contents
+void VerifyPage(gsl::span<const std::byte> page, PageNum pageno);
+// Like VerifyPage(), for `page` read from `file` while the relation is online. A page being written
+// concurrently may be read torn, so it is read again into `page`, up to TORN_READ_RETRIES times,
+// before error::CorruptPage is thrown.
+void VerifyPageWithRetry(const blockio::FileDesc &file, gsl::span<std::byte> page, PageNum pageno);
+} // namespace wbtree::detail
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <filesystem>
+#include <gsl/span>
+#include <memory>
+#include <new>
+
+#include "blockio.hpp"
+#include "decls.hpp"
+
+namespace wbtree::detail {
+// Chunk of the relation read at a time. Large, so that a scan is sequential.
+static constexpr usize SCAN_READ_SIZE = 4 * 1024 * 1024;
+// Alignment of scan buffers, as required by O_DIRECT
+static constexpr usize SCAN_BUFFER_ALIGN = 4096;
+
+struct ScanBufferFree {
+  void operator()(std::byte *buf) const {
+    ::operator delete[](buf, std::align_val_t(SCAN_BUFFER_ALIGN));
+  }
+};
+
+// Plain pages rather than a MappedRegion, so that scans do not take the huge pages set aside for
+// the buffer pool
+using ScanBuffer = std::unique_ptr<std::byte[], ScanBufferFree>;
+
+// Sequential scan of the pages of a relation file, while the relation stays online. The file is
+// read in chunks with O_DIRECT, where the file system supports it, so that the scan does not flush
+// the page cache, and as BACKGROUND_READ, so that a ScheduledIO throttles it behind foreground
+// reads. Chunks may be scanned concurrently, each into its own buffer. A trailing partial page is
+// not scanned.
+class PageScanner {
+public:
+  PageScanner(blockio::IOMethods &io, const std::filesystem::path &path, usize page_size);
+
+  [[nodiscard]] auto File() const -> const blockio::FileDesc & { return m_file; }
+  [[nodiscard]] auto FileSize() const -> usize { return m_filesize; }
+  [[nodiscard]] auto NumPages() const -> u64 { return m_filesize / m_page_size; }
+  [[nodiscard]] auto NumChunks() const -> usize;
+
+  [[nodiscard]] auto ChunkBuffer() const -> ScanBuffer;
+
+  // Reads chunk `c` into `buf` and calls `fn(page, pageno)` for each of its pages. All IO issued
+  // by `fn` is tagged BACKGROUND_READ as well.
+  template <typename Fn> void ScanChunk(usize c, const ScanBuffer &buf, Fn &&fn) const {
+    BOOST_ASSERT(c < NumChunks() && buf);
+    blockio::IOPriorityScope prio(blockio::IOPriority::BACKGROUND_READ);
+    auto off = c * m_chunk_size;
+    auto size = std::min(m_chunk_size, NumPages() * m_page_size - off);
+
+    blockio::ReadFully(m_file, buf.get(), size, static_cast<isize>(off));
+    for (usize pos = 0; pos < size; pos += m_page_size)
+      fn(gsl::span<std::byte>(buf.get() + pos, m_page_size), PageNum((off + pos) / m_page_size));
+  }
+
+  // Scans all chunks in order
+  template <typename Fn> void Scan(Fn &&fn) const {
+    auto buf = ChunkBuffer();
+    for (usize c = 0; c < NumChunks(); c++)
+      ScanChunk(c, buf, fn);
+  }
+
+private:
+  blockio::FileDesc m_file;
+  usize m_page_size;
+  usize m_filesize;
+  usize m_chunk_size;
+};
+} // namespace wbtree::detail
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <vector>
+
+#include "blockio.hpp"
+#include "decls.hpp"
+
+namespace wbtree::detail {
+// Fill factor histogram buckets, each covering 1 / FILL_BUCKETS of the page payload
+static constexpr usize FILL_BUCKETS = 10;
+
+struct LevelStats {
+  u64 pages = 0;
+  u64 used_bytes = 0;
+  std::array<u64, FILL_BUCKETS> fill_histogram{};
+};
+
+struct RelationStats {
+  u64 pages = 0;
+  u64 free_pages = 0;
+  u64 overflow_pages = 0;
+  std::vector<LevelStats> levels; // indexed by level, 0 being the leaves
+  u64 leaves_out_of_order = 0;    // leaves whose right sibling is not the next page on disk
+  std::vector<PageNum> corrupt_pages;
+
+  [[nodiscard]] auto Height() const -> usize { return levels.size(); }
+  // Average fill of the pages at `level`, in [0, 1]
+  [[nodiscard]] auto FillFactor(usize level, usize page_size) const -> double;
+  // Fraction of the leaves that are out of order on disk, in [0, 1]
+  [[nodiscard]] auto Fragmentation() const -> double;
+};
+
+// Walks all pages of relation file `path` with `nworkers` threads, each scanning its own chunks of
+// a PageScanner, while the relation stays online. Pages failing verification are read again, as
+// they may have been read torn, and those still failing are reported in `corrupt_pages` instead of
+// raising error::CorruptPage, so that one bad page does not hide the rest of the report.
+auto AnalyzeRelation(blockio::IOMethods &io, const std::filesystem::path &path, usize page_size,
+                     usize nworkers) -> RelationStats;
+} // namespace wbtree::detail
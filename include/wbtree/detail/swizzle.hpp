@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <boost/assert.hpp>
+#include <cstdint>
+
+#include "decls.hpp"
+#include "errors.hpp"
+#include "page.hpp"
+#include "wbtree/common/bits.hpp"
+
+namespace wbtree::detail {
+static_assert(Bits<u64>::GetReverse(INVALID_PAGE.get(), 0) == 0,
+              "page numbers must leave the swizzle tag bit clear");
+
+// Child pointer held in the in-memory copy of an inner node. While the child is resident, it is
+// swizzled into a direct pointer to the child's buffer frame, so that descending through it needs
+// no PageID to frame lookup. The most significant bit, unused by both user space addresses and
+// page numbers, tags a swizzled pointer. It is unswizzled back into the page number before the
+// child is evicted, or before the parent is written out.
+template <typename Frame> class SwizzledPtr {
+  static_assert(sizeof(Frame *) == sizeof(u64), "pointer swizzling requires 64 bit pointers");
+
+public:
+  SwizzledPtr() = default;
+  explicit SwizzledPtr(PageNum pageno) : m_word(check_pageno(pageno)) {}
+
+  // A snapshot of the pointer, which may be swizzled or unswizzled concurrently
+  class Value {
+  public:
+    [[nodiscard]] auto IsSwizzled() const -> bool { return is_swizzled(m_word); }
+    [[nodiscard]] auto AsPageNum() const -> PageNum {
+      BOOST_ASSERT(!IsSwizzled());
+      return PageNum(m_word);
+    }
+    [[nodiscard]] auto AsFrame() const -> Frame * {
+      BOOST_ASSERT(IsSwizzled());
+      return reinterpret_cast<Frame *>(static_cast<uintptr_t>(Bits<u64>::ClearReverse(m_word, 0)));
+    }
+
+  private:
+    friend class SwizzledPtr;
+    explicit Value(u64 word) : m_word(word) {}
+
+    u64 m_word;
+  };
+
+  [[nodiscard]] auto Load() const -> Value { return Value(m_word.load(std::memory_order_acquire)); }
+
+  // Replaces `pageno` with `frame`, once the child has been loaded. Returns false, if the pointer
+  // no longer refers to `pageno`, i.e. some other thread swizzled it first.
+  auto Swizzle(PageNum pageno, Frame *frame) -> bool {
+    auto expected = pageno.get();
+    auto word = Bits<u64>::SetReverse(static_cast<u64>(reinterpret_cast<uintptr_t>(frame)), 0);
+
+    BOOST_ASSERT(!is_swizzled(static_cast<u64>(reinterpret_cast<uintptr_t>(frame))));
+    return m_word.compare_exchange_strong(expected, word, std::memory_order_acq_rel);
+  }
+
+  // Replaces `frame` with `pageno`, before the child is evicted. Returns false, if the pointer no
+  // longer refers to `frame`.
+  auto Unswizzle(Frame *frame, PageNum pageno) -> bool {
+    check_pageno(pageno);
+    auto expected = Bits<u64>::SetReverse(static_cast<u64>(reinterpret_cast<uintptr_t>(frame)), 0);
+    return m_word.compare_exchange_strong(expected, pageno.get(), std::memory_order_acq_rel);
+  }
+
+private:
+  // A page number reaching the tag bit can only come from a damaged page, and would otherwise be
+  // taken for a frame pointer
+  static auto check_pageno(PageNum pageno) -> u64 {
+    if (pageno > INVALID_PAGE)
+      throw error::CorruptPage("page number {} overlaps the swizzle tag bit", pageno.get());
+    return pageno.get();
+  }
+
+  [[nodiscard]] static constexpr auto is_swizzled(u64 word) -> bool {
+    return Bits<u64>::GetReverse(word, 0) != 0;
+  }
+
+  std::atomic<u64> m_word{INVALID_PAGE.get()};
+};
+} // namespace wbtree::detail
@@ -0,0 +1,62 @@
+#include <algorithm>
+
+#include "wbtree/detail/backup.hpp"
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/page.hpp"
+#include "wbtree/detail/page_scan.hpp"
+
+using namespace wbtree::blockio;
+
+namespace wbtree::detail {
+auto BackupRelation(IOMethods &io, const std::filesystem::path &src,
+                    const std::filesystem::path &dst, usize page_size, LogSeqNum start_redo,
+                    Option<LogSeqNum> since) -> BackupResult {
+  PageScanner scan(io, src, page_size);
+  auto out = OpenWith(io, dst.c_str(), OpenFlags::WRITE | OpenFlags::CREAT | OpenFlags::TRUNC,
+                      CreateMode::USR_READ | CreateMode::USR_WRITE);
+
+  if (scan.FileSize() % page_size != 0) {
+    throw error::CorruptPage("relation size {} is not a multiple of page size {}",
+                             scan.FileSize(), page_size);
+  }
+
+  BackupResult res{0, 0, 0, LogSeqNum(0)};
+  auto newer = [&](LogSeqNum lsn) { return !since || lsn > *since; };
+
+  scan.Scan([&](gsl::span<std::byte> page, PageNum pageno) {
+    res.pages_scanned++;
+    if (!newer(ReadPageHeader(page).lsn))
+      return;
+
+    // A page still torn after re-reading it, and modified since the backup started, is rewritten
+    // by the WAL replay. One last modified before then is damaged.
+    try {
+      VerifyPageWithRetry(scan.File(), page, pageno);
+    } catch (const error::CorruptPage &) {
+      if (ReadPageHeader(page).lsn < start_redo)
+        throw;
+      res.pages_torn++;
+    }
+
+    auto hdr = ReadPageHeader(page);
+    if (!newer(hdr.lsn))
+      return;
+    if (out.Write(page.data(), page_size, PageOffset(pageno, page_size)) !=
+        static_cast<isize>(page_size))
+      throw error::BlockIO("short write of backup page {}", pageno.get());
+
+    res.pages_copied++;
+    res.max_lsn = std::max(res.max_lsn, hdr.lsn);
+  });
+
+  // keep trailing skipped pages as holes
+  out.Truncate(static_cast<isize>(scan.FileSize()));
+  out.DataSync();
+  return res;
+}
+
+auto BackupWALRange(const ControlData &start, const ControlData &end) -> WALRange {
+  return {WALSegNum(start.RedoLSN().get() / ControlData::WAL_SEGMENT_LEN),
+          end.CurrentWALSegment()};
+}
+} // namespace wbtree::detail
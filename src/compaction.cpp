@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "wbtree/detail/compaction.hpp"
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/page.hpp"
+#include "wbtree/detail/page_scan.hpp"
+
+using namespace wbtree::blockio;
+
+namespace wbtree::detail {
+namespace {
+struct LeafInfo {
+  PageNum next;
+  u32 used;
+};
+
+struct Layout {
+  u64 npages = 0;
+  std::unordered_map<u64, LeafInfo> leaves;
+  std::vector<PageNum> free_pages; // in ascending order
+};
+
+auto scan_layout(IOMethods &io, const std::filesystem::path &path, usize page_size) -> Layout {
+  PageScanner scan(io, path, page_size);
+  Layout layout;
+
+  scan.Scan([&](gsl::span<std::byte> page, PageNum pageno) {
+    VerifyPageWithRetry(scan.File(), page, pageno);
+    auto hdr = ReadPageHeader(page);
+    if (hdr.kind == PageKind::LEAF)
+      layout.leaves.emplace(pageno.get(), LeafInfo{hdr.next, hdr.used});
+    else if (hdr.kind == PageKind::FREE)
+      layout.free_pages.push_back(pageno);
+  });
+
+  layout.npages = scan.NumPages();
+  return layout;
+}
+
+// Leaves in key order, starting from the leftmost leaf, which is the one no sibling links to
+auto leaf_chain(const Layout &layout) -> std::vector<PageNum> {
+  std::unordered_set<u64> linked;
+  for (const auto &[pageno, leaf] : layout.leaves) {
+    if (leaf.next != INVALID_PAGE)
+      linked.insert(leaf.next.get());
+  }
+
+  std::vector<PageNum> heads;
+  for (const auto &[pageno, leaf] : layout.leaves) {
+    if (linked.count(pageno) == 0)
+      heads.emplace_back(pageno);
+  }
+  if (heads.size() > 1)
+    throw error::CorruptPage("leaf chain has {} leftmost leaves", heads.size());
+  if (heads.empty() && !layout.leaves.empty())
+    throw error::CorruptPage("leaf chain of {} leaves is cyclic", layout.leaves.size());
+
+  std::vector<PageNum> chain;
+  for (auto cur = heads.empty() ? INVALID_PAGE : heads[0]; cur != INVALID_PAGE;) {
+    auto it = layout.leaves.find(cur.get());
+    if (it == layout.leaves.end() || chain.size() == layout.leaves.size())
+      throw error::CorruptPage("leaf chain is broken at page {}", cur.get());
+    chain.push_back(cur);
+    cur = it->second.next;
+  }
+
+  return chain;
+}
+
+// First page of the first run of `count` consecutive free pages, or the end of the file
+auto find_extent(const Layout &layout, usize count) -> PageNum {
+  usize run = 0;
+
+  for (usize i = 0; i < layout.free_pages.size(); i++) {
+    run = i != 0 && layout.free_pages[i] == layout.free_pages[i - 1] + PageNum(1) ? run + 1 : 1;
+    if (run == count)
+      return layout.free_pages[i + 1 - count];
+  }
+
+  return PageNum(layout.npages);
+}
+} // namespace
+
+auto PlanCompaction(IOMethods &io, const std::filesystem::path &path, usize page_size,
+                    double max_fill) -> CompactionPlan {
+  auto layout = scan_layout(io, path, page_size);
+  auto chain = leaf_chain(layout);
+  auto limit = static_cast<usize>(static_cast<double>(PagePayloadSize(page_size)) * max_fill);
+  CompactionPlan plan;
+  std::vector<PageNum> survivors;
+
+  for (usize i = 0; i < chain.size();) {
+    std::vector<PageNum> run{chain[i]};
+    usize used = layout.leaves.at(chain[i].get()).used;
+
+    while (++i < chain.size() && used + layout.leaves.at(chain[i].get()).used <= limit) {
+      used += layout.leaves.at(chain[i].get()).used;
+      run.push_back(chain[i]);
+    }
+
+    survivors.push_back(run.front());
+    if (run.size() > 1) {
+      plan.pages_freed += run.size() - 1;
+      plan.merges.push_back(std::move(run));
+    }
+  }
+
+  auto contiguous = std::adjacent_find(survivors.begin(), survivors.end(), [](auto a, auto b) {
+                      return b != a + PageNum(1);
+                    }) == survivors.end();
+  if (contiguous)
+    return plan;
+
+  auto extent = find_extent(layout, survivors.size());
+  for (usize i = 0; i < survivors.size(); i++) {
+    auto to = extent + PageNum(i);
+    if (survivors[i] != to)
+      plan.moves.emplace_back(survivors[i], to);
+  }
+
+  return plan;
+}
+} // namespace wbtree::detail
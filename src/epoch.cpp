@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <utility>
+
+#include "wbtree/detail/epoch.hpp"
+
+namespace wbtree::detail {
+EpochManager::~EpochManager() {
+  // all participants must have exited, so everything left is unreachable
+  for (auto &rec : m_records) {
+    BOOST_ASSERT(!rec->in_use.load());
+    BOOST_ASSERT(rec->limbo.empty());
+  }
+  run_deleters(std::exchange(m_orphans, {}));
+}
+
+EpochManager::Guard::Guard(EpochManager &mgr, ThreadRecord &rec) : m_rec(rec) {
+  if (m_rec.pin_depth++ != 0)
+    return;
+
+  // Announce the epoch, and retry if it moved before the announcement became visible, so that a
+  // concurrent try_advance() never misses a thread pinned to an older epoch.
+  auto epoch = mgr.m_global_epoch.load(std::memory_order_relaxed);
+  while (true) {
+    m_rec.epoch.store(epoch, std::memory_order_seq_cst);
+    auto cur = mgr.m_global_epoch.load(std::memory_order_seq_cst);
+    if (cur == epoch)
+      break;
+    epoch = cur;
+  }
+}
+
+EpochManager::Guard::~Guard() {
+  BOOST_ASSERT(m_rec.pin_depth != 0);
+  if (--m_rec.pin_depth == 0)
+    m_rec.epoch.store(QUIESCENT, std::memory_order_release);
+}
+
+EpochManager::Participant::~Participant() {
+  if (m_rec != nullptr)
+    m_mgr->unregister(*m_rec);
+}
+
+EpochManager::Participant::Participant(Participant &&o) noexcept
+    : m_mgr(o.m_mgr), m_rec(std::exchange(o.m_rec, nullptr)) {}
+
+void EpochManager::Participant::Retire(void *ptr, void (*deleter)(void *)) {
+  m_rec->limbo.push_back({ptr, deleter, m_mgr->CurrentEpoch()});
+
+  if (m_rec->limbo.size() >= RECLAIM_BATCH)
+    Reclaim();
+}
+
+void EpochManager::Participant::Reclaim() {
+  m_mgr->try_advance();
+  auto batch = m_mgr->take_safe(m_rec->limbo);
+
+  {
+    std::lock_guard lock(m_mgr->m_lock);
+    auto orphans = m_mgr->take_safe(m_mgr->m_orphans);
+    batch.insert(batch.end(), orphans.begin(), orphans.end());
+  }
+
+  // Deleters run with no lock held and off the limbo lists, so that they may retire objects too
+  run_deleters(std::move(batch));
+}
+
+auto EpochManager::Register() -> Participant {
+  std::lock_guard lock(m_lock);
+
+  for (auto &rec : m_records) {
+    if (!rec->in_use.load(std::memory_order_relaxed)) {
+      rec->in_use.store(true, std::memory_order_relaxed);
+      return {*this, *rec};
+    }
+  }
+
+  m_records.push_back(std::make_unique<ThreadRecord>());
+  return {*this, *m_records.back()};
+}
+
+void EpochManager::try_advance() {
+  std::lock_guard lock(m_lock);
+  auto epoch = m_global_epoch.load(std::memory_order_seq_cst);
+
+  for (auto &rec : m_records) {
+    auto announced = rec->epoch.load(std::memory_order_seq_cst);
+    if (announced != QUIESCENT && announced != epoch)
+      return;
+  }
+
+  m_global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+}
+
+void EpochManager::unregister(ThreadRecord &rec) {
+  BOOST_ASSERT(rec.pin_depth == 0);
+  std::lock_guard lock(m_lock);
+
+  m_orphans.insert(m_orphans.end(), rec.limbo.begin(), rec.limbo.end());
+  rec.limbo.clear();
+  rec.in_use.store(false, std::memory_order_relaxed);
+}
+
+auto EpochManager::take_safe(std::vector<Retired> &limbo) const -> std::vector<Retired> {
+  auto epoch = m_global_epoch.load(std::memory_order_acquire);
+  auto safe = std::stable_partition(limbo.begin(), limbo.end(),
+                                    [epoch](const Retired &r) { return r.epoch + 2 <= epoch; });
+  std::vector<Retired> batch(limbo.begin(), safe);
+
+  limbo.erase(limbo.begin(), safe);
+  return batch;
+}
+
+void EpochManager::run_deleters(std::vector<Retired> batch) {
+  for (const auto &r : batch)
+    r.deleter(r.ptr);
+}
+} // namespace wbtree::detail
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <boost/assert.hpp>
+
+#include "wbtree/detail/frame_memory.hpp"
+
+namespace wbtree::detail {
+FrameMemory::FrameMemory(usize nframes, usize frame_size, usize desc_size)
+    : m_nframes(nframes), m_frame_size(frame_size), m_desc_size(desc_size) {
+  BOOST_ASSERT(nframes != 0);
+  const auto &nodes = MemoryNumaNodes();
+  auto nparts = std::min(nodes.size(), nframes);
+  usize first = 0;
+
+  // Nodes without a partition of their own, such as memoryless ones, are spread over the others
+  m_node_partition.resize(static_cast<usize>(nodes.back()) + 1);
+  for (usize node = 0; node < m_node_partition.size(); node++)
+    m_node_partition[node] = node % nparts;
+
+  for (usize part = 0; part < nparts; part++) {
+    auto count = nframes / nparts + (part < nframes % nparts ? 1 : 0);
+    auto p = std::make_unique<Partition>();
+
+    p->node = nodes[part];
+    p->frames = MappedRegion(count * frame_size, p->node);
+    p->descs = MappedRegion(count * desc_size, p->node);
+    p->first = first;
+    p->count = count;
+
+    first += count;
+    m_node_partition[static_cast<usize>(p->node)] = part;
+    m_partitions.push_back(std::move(p));
+  }
+}
+
+auto FrameMemory::LocalPartition() const -> usize {
+  auto node = static_cast<usize>(CurrentNumaNode());
+  if (node < m_node_partition.size())
+    return m_node_partition[node];
+  return node % m_partitions.size();
+}
+
+auto FrameMemory::PartitionFrames(usize part) const -> std::pair<usize, usize> {
+  const auto &p = *m_partitions[part];
+  return {p.first, p.count};
+}
+
+auto FrameMemory::Frame(usize frameno) const -> std::byte * {
+  const auto &p = partition_of(frameno);
+  return p.frames.Data() + (frameno - p.first) * m_frame_size;
+}
+
+auto FrameMemory::Descriptor(usize frameno) const -> std::byte * {
+  const auto &p = partition_of(frameno);
+  return p.descs.Data() + (frameno - p.first) * m_desc_size;
+}
+
+auto FrameMemory::ClockTick(usize part) -> usize {
+  auto &p = *m_partitions[part];
+  BOOST_ASSERT(p.count != 0);
+  return p.first + p.clock_hand.fetch_add(1, std::memory_order_relaxed) % p.count;
+}
+
+auto FrameMemory::partition_of(usize frameno) const -> const Partition & {
+  BOOST_ASSERT(frameno < m_nframes);
+  // partitions are of near equal size, so start from the estimate and adjust
+  auto part = std::min(frameno / std::max<usize>(m_nframes / m_partitions.size(), 1),
+                       m_partitions.size() - 1);
+
+  while (frameno < m_partitions[part]->first)
+    part--;
+  while (frameno >= m_partitions[part]->first + m_partitions[part]->count)
+    part++;
+  return *m_partitions[part];
+}
+} // namespace wbtree::detail
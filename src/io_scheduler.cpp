@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <limits>
+
+#include "wbtree/detail/io_scheduler.hpp"
+
+namespace wbtree::blockio {
+namespace {
+// Background budget is refilled, and waiting background requests reconsidered, at this interval
+constexpr auto REFILL_INTERVAL = std::chrono::milliseconds(10);
+// Foreground reads are considered waiting for this long after the last one completes, so that
+// background IO does not slip in between back to back reads
+constexpr auto FOREGROUND_GRACE = std::chrono::milliseconds(10);
+constexpr u64 US_PER_SEC = 1'000'000;
+
+// Bytes earned at `bandwidth` bytes per second in `us` microseconds, saturating instead of
+// overflowing after a long idle period
+auto earned_bytes(u64 bandwidth, u64 us) -> u64 {
+  if (us != 0 && bandwidth > std::numeric_limits<u64>::max() / us)
+    return std::numeric_limits<u64>::max() / US_PER_SEC;
+  return bandwidth * us / US_PER_SEC;
+}
+} // namespace
+
+ScheduledIO::ScheduledIO(IOMethods &io, IOSchedulerConfig config) : m_io(io) {
+  auto &bgread = m_classes[static_cast<usize>(IOPriority::BACKGROUND_READ)];
+  auto &bgwrite = m_classes[static_cast<usize>(IOPriority::BACKGROUND_WRITE)];
+  auto &checkpoint = m_classes[static_cast<usize>(IOPriority::CHECKPOINT)];
+
+  bgread.queue_depth = std::max<u32>(config.background_read_queue_depth, 1);
+  bgread.bandwidth = config.background_read_bandwidth;
+  bgwrite.queue_depth = std::max<u32>(config.background_write_queue_depth, 1);
+  bgwrite.bandwidth = config.background_write_bandwidth;
+  checkpoint.queue_depth = std::max<u32>(config.checkpoint_queue_depth, 1);
+  checkpoint.bandwidth = config.checkpoint_bandwidth;
+
+  auto now = Clock::now();
+  for (auto &cls : m_classes)
+    cls.refilled = now;
+}
+
+ScheduledIO::Ticket::Ticket(ScheduledIO &sched, usize bytes, bool read)
+    : m_sched(sched), m_prio(CurrentIOPriority()),
+      m_foreground(read && m_prio == IOPriority::FOREGROUND_READ) {
+  m_sched.admit(m_prio, bytes, m_foreground);
+}
+
+ScheduledIO::Ticket::~Ticket() { m_sched.release(m_prio, m_foreground); }
+
+void ScheduledIO::admit(IOPriority prio, usize bytes, bool foreground) {
+  BOOST_ASSERT(prio < IOPriority::LAST);
+  std::unique_lock lock(m_lock);
+  auto &cls = m_classes[static_cast<usize>(prio)];
+
+  if (foreground)
+    m_foreground_waiting++;
+
+  while (is_background(prio)) {
+    auto now = Clock::now();
+    if (m_foreground_waiting == 0 && now - m_foreground_done >= FOREGROUND_GRACE)
+      break;
+
+    refill(cls, now);
+
+    // A request may overdraw the budget, so that requests larger than a refill window still get
+    // through. The debt is repaid by the requests that follow.
+    if (cls.inflight < cls.queue_depth && cls.budget > 0) {
+      cls.budget -= static_cast<i64>(bytes);
+      break;
+    }
+    m_cv.wait_until(lock, now + REFILL_INTERVAL);
+  }
+
+  cls.inflight++;
+}
+
+void ScheduledIO::release(IOPriority prio, bool foreground) {
+  std::lock_guard lock(m_lock);
+  auto &cls = m_classes[static_cast<usize>(prio)];
+
+  BOOST_ASSERT(cls.inflight != 0);
+  cls.inflight--;
+
+  if (foreground) {
+    m_foreground_waiting--;
+    m_foreground_done = Clock::now();
+  } else if (is_background(prio)) {
+    m_cv.notify_all();
+  }
+}
+
+void ScheduledIO::refill(ClassState &cls, Clock::time_point now) const {
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - cls.refilled);
+  if (elapsed < REFILL_INTERVAL)
+    return;
+
+  auto window = std::chrono::duration_cast<std::chrono::microseconds>(REFILL_INTERVAL);
+  auto burst = std::max<i64>(
+      static_cast<i64>(earned_bytes(cls.bandwidth, static_cast<u64>(window.count()))), 1);
+  auto earned = static_cast<i64>(earned_bytes(cls.bandwidth, static_cast<u64>(elapsed.count())));
+
+  // Nothing is earned past a full window
+  if (cls.budget + earned >= burst) {
+    cls.budget = burst;
+    cls.refilled = now;
+    return;
+  }
+  if (earned == 0)
+    return;
+
+  // Only the time the whole bytes took is used up, so that the fraction of a byte carries over
+  // to the next refill, and low bandwidths still earn something
+  cls.budget += earned;
+  auto credited = (static_cast<u64>(earned) * US_PER_SEC + cls.bandwidth - 1) / cls.bandwidth;
+  cls.refilled += std::chrono::microseconds(credited);
+}
+
+auto ScheduledIO::Open(std::string_view path, u32 flags, u32 mode) -> fd_t {
+  return m_io.Open(path, flags, mode);
+}
+
+void ScheduledIO::Close(fd_t fd) { m_io.Close(fd); }
+
+auto ScheduledIO::Seek(fd_t fd, isize off, Whence whence) -> isize {
+  return m_io.Seek(fd, off, whence);
+}
+
+auto ScheduledIO::Write(fd_t fd, const void *buf, usize size) -> isize {
+  Ticket ticket(*this, size, false);
+  return m_io.Write(fd, buf, size);
+}
+
+auto ScheduledIO::Write(fd_t fd, const void *buf, usize size, isize off) -> isize {
+  Ticket ticket(*this, size, false);
+  return m_io.Write(fd, buf, size, off);
+}
+
+auto ScheduledIO::Read(fd_t fd, void *buf, usize size) -> isize {
+  Ticket ticket(*this, size, true);
+  return m_io.Read(fd, buf, size);
+}
+
+auto ScheduledIO::Read(fd_t fd, void *buf, usize size, isize off) -> isize {
+  Ticket ticket(*this, size, true);
+  return m_io.Read(fd, buf, size, off);
+}
+
+void ScheduledIO::Sync(fd_t fd) {
+  Ticket ticket(*this, 0, false);
+  m_io.Sync(fd);
+}
+
+void ScheduledIO::DataSync(fd_t fd) {
+  Ticket ticket(*this, 0, false);
+  m_io.DataSync(fd);
+}
+
+void ScheduledIO::Truncate(fd_t fd, isize off) { m_io.Truncate(fd, off); }
+} // namespace wbtree::blockio
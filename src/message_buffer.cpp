@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/message_buffer.hpp"
+
+namespace wbtree::detail {
+namespace {
+auto compare_keys(gsl::span<const std::byte> a, gsl::span<const std::byte> b) -> int {
+  auto len = static_cast<usize>(std::min(a.size(), b.size()));
+  if (auto res = len != 0 ? std::memcmp(a.data(), b.data(), len) : 0; res != 0)
+    return res;
+  return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+} // namespace
+
+MessageBuffer::MessageBuffer(gsl::span<std::byte> region) : m_region(region) {
+  BOOST_ASSERT(static_cast<usize>(region.size()) >= sizeof(Header));
+}
+
+auto MessageBuffer::Init(gsl::span<std::byte> region) -> MessageBuffer {
+  MessageBuffer buf(region);
+  buf.Clear();
+  return buf;
+}
+
+auto MessageBuffer::Count() const -> usize { return header().count; }
+
+auto MessageBuffer::FreeSpace() const -> usize {
+  return static_cast<usize>(m_region.size()) - sizeof(Header) - header().used;
+}
+
+auto MessageBuffer::Fits(gsl::span<const std::byte> key, gsl::span<const std::byte> value) const
+    -> bool {
+  return message_size(key.size(), value.size()) <= FreeSpace();
+}
+
+auto MessageBuffer::Append(const Message &msg) -> bool {
+  auto value = msg.kind == MessageKind::DELETE ? gsl::span<const std::byte>{} : msg.value;
+  auto size = message_size(msg.key.size(), value.size());
+
+  if (msg.key.size() > std::numeric_limits<u16>::max() ||
+      size > static_cast<usize>(m_region.size()) - sizeof(Header)) {
+    throw error::ElementTooBig("{prefix}: message of {} bytes exceeds buffer capacity of {} bytes",
+                               size, m_region.size() - sizeof(Header));
+  }
+  if (size > FreeSpace())
+    return false;
+
+  auto hdr = header();
+  auto *dst = m_region.data() + sizeof(Header) + hdr.used;
+  MessageHeader mhdr{msg.kind, 0, static_cast<u16>(msg.key.size()),
+                     static_cast<u32>(value.size())};
+
+  std::memcpy(dst, &mhdr, sizeof(mhdr));
+  dst += sizeof(mhdr);
+  if (!msg.key.empty())
+    std::memcpy(dst, msg.key.data(), msg.key.size());
+  dst += msg.key.size();
+  if (!value.empty())
+    std::memcpy(dst, value.data(), value.size());
+
+  hdr.count++;
+  hdr.used += static_cast<u32>(size);
+  set_header(hdr);
+  return true;
+}
+
+auto MessageBuffer::Lookup(gsl::span<const std::byte> key) const -> Option<Message> {
+  Option<Message> latest;
+  auto hdr = header();
+
+  for (usize off = 0, i = 0; i < hdr.count; i++) {
+    auto msg = message_at(off);
+
+    if (compare_keys(msg.key, key) == 0)
+      latest = msg;
+    off += message_size(msg.key.size(), msg.value.size());
+  }
+
+  return latest;
+}
+
+void MessageBuffer::Clear() { set_header({0, 0}); }
+
+auto MessageBuffer::header() const -> Header {
+  Header hdr;
+  std::memcpy(&hdr, m_region.data(), sizeof(hdr));
+  return hdr;
+}
+
+void MessageBuffer::set_header(const Header &hdr) {
+  std::memcpy(m_region.data(), &hdr, sizeof(hdr));
+}
+
+auto MessageBuffer::message_at(usize off) const -> Message {
+  const auto *src = m_region.data() + sizeof(Header) + off;
+  MessageHeader mhdr;
+
+  std::memcpy(&mhdr, src, sizeof(mhdr));
+  src += sizeof(mhdr);
+
+  return {mhdr.kind, {src, mhdr.key_len}, {src + mhdr.key_len, mhdr.value_len}};
+}
+
+auto MessageBuffer::sorted_offsets() const -> std::vector<usize> {
+  auto hdr = header();
+  std::vector<usize> offsets;
+
+  offsets.reserve(hdr.count);
+  for (usize off = 0, i = 0; i < hdr.count; i++) {
+    offsets.push_back(off);
+    auto msg = message_at(off);
+    off += message_size(msg.key.size(), msg.value.size());
+  }
+
+  // stable sort keeps arrival order among messages of the same key
+  std::stable_sort(offsets.begin(), offsets.end(), [this](usize a, usize b) {
+    return compare_keys(message_at(a).key, message_at(b).key) < 0;
+  });
+
+  return offsets;
+}
+} // namespace wbtree::detail
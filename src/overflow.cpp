@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstring>
+
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/overflow.hpp"
+#include "wbtree/detail/page.hpp"
+
+using namespace wbtree::blockio;
+
+namespace wbtree::detail {
+auto OverflowPageCount(usize page_size, u64 length) -> u64 {
+  auto payload = PagePayloadSize(page_size);
+  return std::max<u64>(1, (length + payload - 1) / payload);
+}
+
+auto WriteOverflow(const FileDesc &file, usize page_size, PageNum first, LogSeqNum lsn,
+                   gsl::span<const std::byte> value) -> OverflowRef {
+  auto npages = OverflowPageCount(page_size, static_cast<u64>(value.size()));
+  auto payload = PagePayloadSize(page_size);
+  std::vector<std::byte> page(page_size);
+  usize written = 0;
+
+  for (u64 i = 0; i < npages; i++) {
+    auto pageno = first + PageNum(i);
+    auto chunk = std::min(payload, static_cast<usize>(value.size()) - written);
+    PageHeader hdr{};
+
+    hdr.lsn = lsn;
+    hdr.kind = PageKind::OVERFLOW;
+    hdr.used = static_cast<u32>(chunk);
+    hdr.next = i + 1 < npages ? pageno + PageNum(1) : INVALID_PAGE;
+
+    std::fill(page.begin(), page.end(), std::byte{0});
+    WritePageHeader(page, hdr);
+    if (chunk != 0)
+      std::memcpy(page.data() + sizeof(PageHeader), value.data() + written, chunk);
+    SetPageChecksum(page);
+
+    if (file.Write(page.data(), page_size, PageOffset(pageno, page_size)) !=
+        static_cast<isize>(page_size)) {
+      throw error::BlockIO("short write of overflow page {}", pageno.get());
+    }
+    written += chunk;
+  }
+
+  return {first, static_cast<u64>(value.size())};
+}
+
+OverflowReader::OverflowReader(const FileDesc &file, usize page_size, OverflowRef ref)
+    : m_file(file), m_page_size(page_size), m_ref(ref), m_next(ref.first), m_page(page_size) {}
+
+auto OverflowReader::Read(gsl::span<std::byte> out) -> usize {
+  usize copied = 0;
+
+  while (copied < static_cast<usize>(out.size()) && Remaining() != 0) {
+    if (m_page_pos == m_page_used)
+      load_next_page();
+
+    auto chunk = std::min({m_page_used - m_page_pos, static_cast<usize>(out.size()) - copied,
+                           static_cast<usize>(Remaining())});
+    std::memcpy(out.data() + copied, m_page.data() + sizeof(PageHeader) + m_page_pos, chunk);
+
+    m_page_pos += chunk;
+    m_consumed += chunk;
+    copied += chunk;
+  }
+
+  return copied;
+}
+
+void OverflowReader::load_next_page() {
+  if (m_next == INVALID_PAGE)
+    throw error::CorruptPage("overflow chain at page {} ends early", m_ref.first.get());
+
+  auto readsize = m_file.Read(m_page.data(), m_page_size, PageOffset(m_next, m_page_size));
+  if (readsize != static_cast<isize>(m_page_size))
+    throw error::CorruptPage("short read of overflow page {}", m_next.get());
+
+  VerifyPage(m_page, m_next);
+
+  auto hdr = ReadPageHeader(m_page);
+  if (hdr.kind != PageKind::OVERFLOW || hdr.used > PagePayloadSize(m_page_size) ||
+      (hdr.used == 0 && Remaining() != 0)) {
+    throw error::CorruptPage("page {} is not a valid overflow page", m_next.get());
+  }
+
+  m_next = hdr.next;
+  m_page_used = hdr.used;
+  m_page_pos = 0;
+}
+} // namespace wbtree::detail
@@ -0,0 +1,65 @@
+#include <boost/assert.hpp>
+#include <crc32c/crc32c.h>
+#include <cstddef>
+#include <cstring>
+
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/page.hpp"
+
+namespace wbtree::detail {
+auto ReadPageHeader(gsl::span<const std::byte> page) -> PageHeader {
+  BOOST_ASSERT(static_cast<usize>(page.size()) >= sizeof(PageHeader));
+  PageHeader hdr;
+  std::memcpy(&hdr, page.data(), sizeof(hdr));
+  return hdr;
+}
+
+void WritePageHeader(gsl::span<std::byte> page, const PageHeader &hdr) {
+  BOOST_ASSERT(static_cast<usize>(page.size()) >= sizeof(PageHeader));
+  std::memcpy(page.data(), &hdr, sizeof(hdr));
+}
+
+auto PageChecksum(gsl::span<const std::byte> page) -> u32 {
+  static constexpr usize CRC_OFF = offsetof(PageHeader, checksum);
+  static constexpr usize REST_OFF = CRC_OFF + sizeof(PageHeader::checksum);
+  const auto *bytes = reinterpret_cast<const u8 *>(page.data());
+
+  auto crc = crc32c::Crc32c(bytes, CRC_OFF);
+  return crc32c::Extend(crc, bytes + REST_OFF, static_cast<usize>(page.size()) - REST_OFF);
+}
+
+void SetPageChecksum(gsl::span<std::byte> page) {
+  auto hdr = ReadPageHeader(page);
+  hdr.checksum = PageChecksum(page);
+  WritePageHeader(page, hdr);
+}
+
+void VerifyPage(gsl::span<const std::byte> page, PageNum pageno) {
+  auto hdr = ReadPageHeader(page);
+  auto crc = PageChecksum(page);
+
+  if (hdr.checksum != crc) {
+    throw error::CorruptPage(R"(page {} checksum mismatch: expected "{}", got "{}")",
+                             pageno.get(), hdr.checksum, crc);
+  }
+  if (hdr.kind >= PageKind::LAST) {
+    throw error::CorruptPage(R"(page {} has invalid kind "{}")", pageno.get(),
+                             static_cast<unsigned>(hdr.kind));
+  }
+}
+
+void VerifyPageWithRetry(const blockio::FileDesc &file, gsl::span<std::byte> page, PageNum pageno) {
+  auto page_size = static_cast<usize>(page.size());
+
+  for (usize retry = 0;; retry++) {
+    try {
+      VerifyPage(page, pageno);
+      return;
+    } catch (const error::CorruptPage &) {
+      if (retry == TORN_READ_RETRIES)
+        throw;
+    }
+    blockio::ReadFully(file, page.data(), page_size, PageOffset(pageno, page_size));
+  }
+}
+} // namespace wbtree::detail
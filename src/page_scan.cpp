@@ -0,0 +1,19 @@
+#include "wbtree/detail/page_scan.hpp"
+
+using namespace wbtree::blockio;
+
+namespace wbtree::detail {
+PageScanner::PageScanner(IOMethods &io, const std::filesystem::path &path, usize page_size)
+    : m_file(OpenDirectWith(io, path.c_str(), OpenFlags::READ)), m_page_size(page_size),
+      m_filesize(static_cast<usize>(m_file.Seek(0, Whence::END))),
+      m_chunk_size(std::max(SCAN_READ_SIZE / page_size, usize{1}) * page_size) {}
+
+auto PageScanner::NumChunks() const -> usize {
+  return (NumPages() * m_page_size + m_chunk_size - 1) / m_chunk_size;
+}
+
+auto PageScanner::ChunkBuffer() const -> ScanBuffer {
+  return ScanBuffer(static_cast<std::byte *>(
+      ::operator new[](m_chunk_size, std::align_val_t(SCAN_BUFFER_ALIGN))));
+}
+} // namespace wbtree::detail
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <gsl/gsl>
+#include <thread>
+
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/page.hpp"
+#include "wbtree/detail/page_scan.hpp"
+#include "wbtree/detail/page_stats.hpp"
+
+using namespace wbtree::blockio;
+
+namespace wbtree::detail {
+namespace {
+void account_page(RelationStats &stats, const FileDesc &file, gsl::span<std::byte> page,
+                  PageNum pageno, usize page_size) {
+  stats.pages++;
+
+  try {
+    VerifyPageWithRetry(file, page, pageno);
+  } catch (const error::CorruptPage &) {
+    stats.corrupt_pages.push_back(pageno);
+    return;
+  }
+
+  auto hdr = ReadPageHeader(page);
+  switch (hdr.kind) {
+  case PageKind::FREE:
+    stats.free_pages++;
+    return;
+  case PageKind::OVERFLOW:
+    stats.overflow_pages++;
+    return;
+  case PageKind::LEAF:
+    if (hdr.next != INVALID_PAGE && hdr.next != pageno + PageNum(1))
+      stats.leaves_out_of_order++;
+    break;
+  default:
+    break;
+  }
+
+  if (stats.levels.size() <= hdr.level)
+    stats.levels.resize(hdr.level + 1U);
+
+  auto payload = PagePayloadSize(page_size);
+  auto used = std::min<usize>(hdr.used, payload);
+  auto bucket = std::min(used * FILL_BUCKETS / payload, FILL_BUCKETS - 1);
+  auto &level = stats.levels[hdr.level];
+
+  level.pages++;
+  level.used_bytes += used;
+  level.fill_histogram[bucket]++;
+}
+
+void merge(RelationStats &into, const RelationStats &from) {
+  into.pages += from.pages;
+  into.free_pages += from.free_pages;
+  into.overflow_pages += from.overflow_pages;
+  into.leaves_out_of_order += from.leaves_out_of_order;
+  into.corrupt_pages.insert(into.corrupt_pages.end(), from.corrupt_pages.begin(),
+                            from.corrupt_pages.end());
+
+  if (into.levels.size() < from.levels.size())
+    into.levels.resize(from.levels.size());
+  for (usize i = 0; i < from.levels.size(); i++) {
+    into.levels[i].pages += from.levels[i].pages;
+    into.levels[i].used_bytes += from.levels[i].used_bytes;
+    for (usize b = 0; b < FILL_BUCKETS; b++)
+      into.levels[i].fill_histogram[b] += from.levels[i].fill_histogram[b];
+  }
+}
+} // namespace
+
+auto RelationStats::FillFactor(usize level, usize page_size) const -> double {
+  const auto &lvl = levels.at(level);
+  if (lvl.pages == 0)
+    return 0;
+  return static_cast<double>(lvl.used_bytes) /
+         static_cast<double>(lvl.pages * PagePayloadSize(page_size));
+}
+
+auto RelationStats::Fragmentation() const -> double {
+  if (levels.empty() || levels[0].pages == 0)
+    return 0;
+  return static_cast<double>(leaves_out_of_order) / static_cast<double>(levels[0].pages);
+}
+
+auto AnalyzeRelation(IOMethods &io, const std::filesystem::path &path, usize page_size,
+                     usize nworkers) -> RelationStats {
+  PageScanner scan(io, path, page_size);
+  auto nchunks = scan.NumChunks();
+
+  nworkers = std::clamp<usize>(nworkers, 1, std::max<usize>(nchunks, 1));
+
+  std::vector<RelationStats> partial(nworkers);
+  std::vector<std::exception_ptr> errors(nworkers);
+  std::atomic<usize> next_chunk{0};
+
+  auto worker = [&](usize id) {
+    try {
+      auto buf = scan.ChunkBuffer();
+
+      for (auto c = next_chunk++; c < nchunks; c = next_chunk++) {
+        scan.ScanChunk(c, buf, [&](gsl::span<std::byte> page, PageNum pageno) {
+          account_page(partial[id], scan.File(), page, pageno, page_size);
+        });
+      }
+    } catch (...) {
+      errors[id] = std::current_exception();
+    }
+  };
+
+  {
+    std::vector<std::thread> threads;
+    // the workers already started must be joined, even if starting the next one throws
+    auto join = gsl::finally([&] {
+      for (auto &t : threads)
+        t.join();
+    });
+
+    for (usize id = 1; id < nworkers; id++)
+      threads.emplace_back(worker, id);
+    worker(0);
+  }
+
+  for (auto &err : errors) {
+    if (err)
+      std::rethrow_exception(err);
+  }
+
+  RelationStats stats;
+  for (const auto &p : partial)
+    merge(stats, p);
+  std::sort(stats.corrupt_pages.begin(), stats.corrupt_pages.end());
+  return stats;
+}
+} // namespace wbtree::detail
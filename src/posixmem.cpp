@@ -0,0 +1,153 @@
+#ifdef __unix__
+#include <algorithm>
+#include <boost/config.hpp>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "wbtree/detail/frame_memory.hpp"
+
+namespace wbtree::detail {
+namespace {
+#ifdef __linux__
+constexpr int MPOL_PREFERRED = 1; // from <numaif.h>, which needs libnuma
+
+void prefer_node(void *addr, usize size, int numa_node) {
+  if (numa_node < 0 || MemoryNumaNodes().size() <= 1)
+    return;
+
+  static constexpr usize WORD_BITS = sizeof(unsigned long) * 8;
+  auto node = static_cast<usize>(numa_node);
+  std::vector<unsigned long> nodemask(node / WORD_BITS + 1);
+  nodemask[node / WORD_BITS] = 1UL << (node % WORD_BITS);
+
+  // best effort: memory is still usable, if the policy cannot be applied
+  (void)::syscall(SYS_mbind, addr, size, MPOL_PREFERRED, nodemask.data(),
+                  nodemask.size() * WORD_BITS + 1, 0);
+}
+
+// Parses a sysfs node list, such as "0,2-3"
+auto parse_node_list(const std::string &list) -> std::vector<int> {
+  std::vector<int> nodes;
+  std::istringstream in(list);
+  std::string range;
+
+  while (std::getline(in, range, ',')) {
+    auto dash = range.find('-');
+    if (range.empty() || range.find_first_not_of("0123456789-") != std::string::npos ||
+        dash == 0 || dash == range.size() - 1)
+      continue;
+    auto first = std::stoi(range.substr(0, dash));
+    auto last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+    for (auto node = first; node <= last; node++)
+      nodes.push_back(node);
+  }
+
+  return nodes;
+}
+
+auto read_node_list(const char *path) -> std::vector<int> {
+  std::ifstream file(path);
+  std::string list;
+
+  if (!std::getline(file, list))
+    return {};
+  return parse_node_list(list);
+}
+#endif
+
+auto round_up(usize size, usize align) -> usize { return (size + align - 1) / align * align; }
+} // namespace
+
+MappedRegion::MappedRegion(usize size, int numa_node) {
+  void *addr = MAP_FAILED;
+
+  if (size == 0)
+    return;
+
+#ifdef MAP_HUGETLB
+  m_size = round_up(size, HUGE_PAGE_SIZE);
+  addr = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+              -1, 0);
+  m_huge = addr != MAP_FAILED;
+#endif
+
+  // No huge pages reserved, fallback to regular pages
+  if (addr == MAP_FAILED) {
+    m_size = round_up(size, static_cast<usize>(sysconf(_SC_PAGESIZE)));
+    addr = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED)
+      throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    (void)madvise(addr, m_size, MADV_HUGEPAGE);
+#endif
+  }
+
+#ifdef __linux__
+  prefer_node(addr, m_size, numa_node);
+#else
+  (void)numa_node;
+#endif
+
+  m_data = static_cast<std::byte *>(addr);
+}
+
+MappedRegion::~MappedRegion() {
+  if (m_data != nullptr)
+    munmap(m_data, m_size);
+}
+
+MappedRegion::MappedRegion(MappedRegion &&o) noexcept
+    : m_data(std::exchange(o.m_data, nullptr)), m_size(std::exchange(o.m_size, 0)),
+      m_huge(std::exchange(o.m_huge, false)) {}
+
+auto MappedRegion::operator=(MappedRegion &&o) noexcept -> MappedRegion & {
+  if (this != &o) {
+    if (m_data != nullptr)
+      munmap(m_data, m_size);
+    m_data = std::exchange(o.m_data, nullptr);
+    m_size = std::exchange(o.m_size, 0);
+    m_huge = std::exchange(o.m_huge, false);
+  }
+  return *this;
+}
+
+auto MemoryNumaNodes() -> const std::vector<int> & {
+  static const std::vector<int> nodes = [] {
+#ifdef __linux__
+    // memoryless nodes cannot back a partition
+    for (const auto *path :
+         {"/sys/devices/system/node/has_memory", "/sys/devices/system/node/online"}) {
+      if (auto list = read_node_list(path); !list.empty())
+        return list;
+    }
+#endif
+    return std::vector<int>{0};
+  }();
+
+  return nodes;
+}
+
+auto CurrentNumaNode() -> int {
+#ifdef __linux__
+  unsigned cpu = 0;
+  unsigned node = 0;
+
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+    return 0;
+  return static_cast<int>(node);
+#else
+  return 0;
+#endif
+}
+} // namespace wbtree::detail
+#endif
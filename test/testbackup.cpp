@@ -0,0 +1,146 @@
+#include <cstddef>
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+#include "wbtree/detail/backup.hpp"
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/page.hpp"
+
+#include "testrelation.hpp"
+
+using namespace wbtree;
+using namespace wbtree::blockio;
+using namespace wbtree::detail;
+
+namespace {
+constexpr usize PAGE_SIZE = 4096;
+// Redo LSN when the backups below start
+constexpr LogSeqNum START_REDO(10);
+
+// Hands the copy of `pageno` in each read covering it to `tear`, along with the number of reads
+// of it so far
+struct TearingIO : SystemIO {
+  TearingIO(PageNum pageno, std::function<void(usize, gsl::span<std::byte>)> tear)
+      : m_pageno(pageno), m_tear(std::move(tear)) {}
+
+  auto Read(fd_t fd, void *buf, usize size, isize off) -> isize override {
+    auto n = SystemIO::Read(fd, buf, size, off);
+    auto pageoff = PageOffset(m_pageno, PAGE_SIZE);
+    if (off <= pageoff && pageoff + static_cast<isize>(PAGE_SIZE) <= off + n)
+      m_tear(m_reads++, {static_cast<std::byte *>(buf) + (pageoff - off), PAGE_SIZE});
+    return n;
+  }
+
+private:
+  PageNum m_pageno;
+  std::function<void(usize, gsl::span<std::byte>)> m_tear;
+  usize m_reads = 0;
+};
+
+auto make_page(u64 lsn, u8 fill) -> std::vector<std::byte> {
+  std::vector<std::byte> page(PAGE_SIZE, std::byte{fill});
+  PageHeader hdr{LogSeqNum(lsn), 0, PageKind::LEAF, 0, 0, 0, 0, INVALID_PAGE};
+  WritePageHeader(page, hdr);
+  SetPageChecksum(page);
+  return page;
+}
+
+auto read_page(const std::filesystem::path &path, PageNum pageno) -> std::vector<std::byte> {
+  SystemIO io;
+  auto file = OpenWith(io, path.c_str(), OpenFlags::READ);
+  std::vector<std::byte> page(PAGE_SIZE);
+  ReadFully(file, page.data(), PAGE_SIZE, PageOffset(pageno, PAGE_SIZE));
+  return page;
+}
+
+// Relation whose page i has LSN lsns[i], and the file it is backed up to
+struct Backup {
+  explicit Backup(const std::vector<u64> &lsns)
+      : src("backup_src", PAGE_SIZE, lsns.size(),
+            [&](usize i) { return make_page(lsns[i], static_cast<u8>(i + 1)); }),
+        dst("backup_dst") {}
+
+  test::Relation src;
+  test::TempFile dst;
+};
+} // namespace
+
+TEST_CASE("full backup copies every page, including those at LSN 0") {
+  Backup rel({0, 0, 7});
+  SystemIO io;
+
+  auto res = BackupRelation(io, rel.src.path, rel.dst.path, PAGE_SIZE, START_REDO, std::nullopt);
+  CHECK(res.pages_scanned == 3);
+  CHECK(res.pages_copied == 3);
+  CHECK(res.pages_torn == 0);
+  CHECK(res.max_lsn == LogSeqNum(7));
+  for (u64 i = 0; i < 3; i++)
+    CHECK(read_page(rel.dst.path, PageNum(i)) == read_page(rel.src.path, PageNum(i)));
+}
+
+TEST_CASE("incremental backup copies newer pages and leaves the rest as holes") {
+  Backup rel({3, 5, 4, 2});
+  SystemIO io;
+
+  auto res = BackupRelation(io, rel.src.path, rel.dst.path, PAGE_SIZE, START_REDO, LogSeqNum(3));
+  CHECK(res.pages_scanned == 4);
+  CHECK(res.pages_copied == 2);
+  CHECK(res.max_lsn == LogSeqNum(5));
+  CHECK(std::filesystem::file_size(rel.dst.path) == 4 * PAGE_SIZE);
+
+  CHECK(read_page(rel.dst.path, PageNum(1)) == read_page(rel.src.path, PageNum(1)));
+  CHECK(read_page(rel.dst.path, PageNum(2)) == read_page(rel.src.path, PageNum(2)));
+  for (u64 i : {0, 3}) {
+    auto hole = read_page(rel.dst.path, PageNum(i));
+    CHECK_THROWS_AS(VerifyPage(hole, PageNum(i)), error::CorruptPage);
+  }
+}
+
+TEST_CASE("torn reads are read again") {
+  Backup rel({1, 2, 3});
+  TearingIO io(PageNum(1), [](usize nth, gsl::span<std::byte> page) {
+    if (nth < TORN_READ_RETRIES)
+      page[100] ^= std::byte{0xff};
+  });
+
+  auto res = BackupRelation(io, rel.src.path, rel.dst.path, PAGE_SIZE, START_REDO, std::nullopt);
+  CHECK(res.pages_copied == 3);
+  CHECK(res.pages_torn == 0);
+  CHECK(read_page(rel.dst.path, PageNum(1)) == read_page(rel.src.path, PageNum(1)));
+}
+
+TEST_CASE("pages torn on every read are copied when modified since the backup started") {
+  Backup rel({1, 12, 3});
+  TearingIO io(PageNum(1), [](usize /*nth*/, gsl::span<std::byte> page) {
+    page[100] ^= std::byte{0xff};
+  });
+
+  auto res = BackupRelation(io, rel.src.path, rel.dst.path, PAGE_SIZE, START_REDO, std::nullopt);
+  CHECK(res.pages_copied == 3);
+  CHECK(res.pages_torn == 1);
+}
+
+TEST_CASE("full backups of damaged pages last modified before the backup started throw") {
+  Backup rel({1, 2, 3});
+  TearingIO io(PageNum(1), [](usize /*nth*/, gsl::span<std::byte> page) {
+    page[100] ^= std::byte{0xff};
+  });
+
+  CHECK_THROWS_AS(
+      BackupRelation(io, rel.src.path, rel.dst.path, PAGE_SIZE, START_REDO, std::nullopt),
+      error::CorruptPage);
+}
+
+TEST_CASE("pages failing verification at an old LSN are corrupt") {
+  Backup rel({1, 0x100, 3});
+  // Modified since the backup started when first read, but not on the re-reads
+  TearingIO io(PageNum(1), [](usize nth, gsl::span<std::byte> page) {
+    page[nth == 0 ? 100 : offsetof(PageHeader, lsn) + 1] = std::byte{0};
+  });
+
+  CHECK_THROWS_AS(
+      BackupRelation(io, rel.src.path, rel.dst.path, PAGE_SIZE, LogSeqNum(0x100), LogSeqNum(0xff)),
+      error::CorruptPage);
+}
@@ -0,0 +1,107 @@
+#include <doctest/doctest.h>
+#include <utility>
+#include <vector>
+
+#include "wbtree/detail/compaction.hpp"
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/page.hpp"
+
+#include "testrelation.hpp"
+
+using namespace wbtree;
+using namespace wbtree::blockio;
+using namespace wbtree::detail;
+
+namespace {
+constexpr usize PAGE_SIZE = 4096;
+constexpr auto QUARTER = static_cast<u32>(PagePayloadSize(PAGE_SIZE) / 4);
+constexpr auto FULL = static_cast<u32>(PagePayloadSize(PAGE_SIZE));
+constexpr u64 INVALID = INVALID_PAGE.get();
+
+auto leaf(u64 next, u32 used) -> PageHeader {
+  return {LogSeqNum(1), 0, PageKind::LEAF, 0, 0, used, 0, PageNum(next)};
+}
+
+auto free_page() -> PageHeader {
+  return {LogSeqNum(1), 0, PageKind::FREE, 0, 0, 0, 0, INVALID_PAGE};
+}
+
+// Relation whose page i has header pages[i]
+struct Relation : test::Relation {
+  explicit Relation(const std::vector<PageHeader> &pages)
+      : test::Relation("compaction", PAGE_SIZE, pages.size(), [&](usize i) {
+          std::vector<std::byte> page(PAGE_SIZE);
+          WritePageHeader(page, pages[i]);
+          SetPageChecksum(page);
+          return page;
+        }) {}
+};
+} // namespace
+
+TEST_CASE("contiguous full leaves need no compaction") {
+  Relation rel({leaf(1, FULL), leaf(2, FULL), leaf(INVALID, FULL), free_page()});
+  SystemIO io;
+
+  auto plan = PlanCompaction(io, rel.path, PAGE_SIZE);
+  CHECK(plan.merges.empty());
+  CHECK(plan.moves.empty());
+  CHECK(plan.pages_freed == 0);
+}
+
+TEST_CASE("adjacent underfull leaves are merged and the survivors moved to a free extent") {
+  // chain 0 -> 1 -> 2 -> 3, free pages 4 and 5
+  Relation rel({leaf(1, QUARTER), leaf(2, QUARTER), leaf(3, QUARTER), leaf(INVALID, QUARTER),
+                free_page(), free_page()});
+  SystemIO io;
+
+  auto plan = PlanCompaction(io, rel.path, PAGE_SIZE);
+  REQUIRE(plan.merges.size() == 1);
+  std::vector<PageNum> merge{PageNum(0), PageNum(1), PageNum(2)};
+  CHECK(plan.merges[0] == merge);
+  CHECK(plan.pages_freed == 2);
+  // survivors 0 and 3 are not adjacent
+  std::vector<std::pair<PageNum, PageNum>> moves{{PageNum(0), PageNum(4)},
+                                                 {PageNum(3), PageNum(5)}};
+  CHECK(plan.moves == moves);
+}
+
+TEST_CASE("survivors are moved past the end of the file without a large enough free extent") {
+  // chain 3 -> 0 -> 2, with free page 1 in between
+  Relation rel({leaf(2, FULL), free_page(), leaf(INVALID, FULL), leaf(0, FULL)});
+  SystemIO io;
+
+  auto plan = PlanCompaction(io, rel.path, PAGE_SIZE);
+  CHECK(plan.merges.empty());
+  std::vector<std::pair<PageNum, PageNum>> moves{
+      {PageNum(3), PageNum(4)}, {PageNum(0), PageNum(5)}, {PageNum(2), PageNum(6)}};
+  CHECK(plan.moves == moves);
+}
+
+TEST_CASE("leaf chains with several leftmost leaves are corrupt") {
+  Relation rel({leaf(INVALID, FULL), leaf(INVALID, FULL)});
+  SystemIO io;
+
+  CHECK_THROWS_AS(PlanCompaction(io, rel.path, PAGE_SIZE), error::CorruptPage);
+}
+
+TEST_CASE("cyclic leaf chains are corrupt") {
+  Relation rel({leaf(1, FULL), leaf(2, FULL), leaf(0, FULL)});
+  SystemIO io;
+
+  CHECK_THROWS_AS(PlanCompaction(io, rel.path, PAGE_SIZE), error::CorruptPage);
+}
+
+TEST_CASE("leaf chains linking to a page that is not a leaf are corrupt") {
+  Relation rel({leaf(1, FULL), free_page()});
+  SystemIO io;
+
+  CHECK_THROWS_AS(PlanCompaction(io, rel.path, PAGE_SIZE), error::CorruptPage);
+}
+
+TEST_CASE("pages failing verification are corrupt") {
+  Relation rel({leaf(1, FULL), leaf(INVALID, FULL)});
+  rel.Damage(PageNum(1));
+  SystemIO io;
+
+  CHECK_THROWS_AS(PlanCompaction(io, rel.path, PAGE_SIZE), error::CorruptPage);
+}
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <doctest/doctest.h>
+#include <thread>
+#include <vector>
+
+#include "wbtree/detail/epoch.hpp"
+
+using namespace wbtree;
+using namespace wbtree::detail;
+
+namespace {
+std::atomic<int> live_objects{0};
+
+struct Object {
+  explicit Object(int v) : value(v) { live_objects++; }
+  ~Object() {
+    value = -1;
+    live_objects--;
+  }
+  Object(const Object &) = delete;
+  Object(Object &&) = delete;
+  auto operator=(const Object &) -> Object & = delete;
+  auto operator=(Object &&) -> Object & = delete;
+
+  int value;
+};
+} // namespace
+
+TEST_CASE("retired objects are freed only after two epoch advances") {
+  EpochManager mgr;
+  auto self = mgr.Register();
+  auto other = mgr.Register();
+  auto start = live_objects.load();
+
+  {
+    auto pinned = other.Pin();
+    self.Retire(new Object(1));
+    self.Reclaim();
+    self.Reclaim();
+    // `other` stays pinned in an epoch that may still see the object
+    CHECK(live_objects == start + 1);
+    CHECK(mgr.CurrentEpoch() <= 1);
+  }
+
+  self.Reclaim();
+  self.Reclaim();
+  CHECK(live_objects == start);
+}
+
+TEST_CASE("limbo of an exited participant is reclaimed by the others") {
+  EpochManager mgr;
+  auto start = live_objects.load();
+  auto self = mgr.Register();
+
+  {
+    auto leaving = mgr.Register();
+    leaving.Retire(new Object(1));
+  }
+  CHECK(live_objects == start + 1);
+
+  for (int i = 0; i < 3; i++)
+    self.Reclaim();
+  CHECK(live_objects == start);
+}
+
+TEST_CASE("deleters may retire further objects") {
+  EpochManager mgr;
+  auto start = live_objects.load();
+  auto self = mgr.Register();
+  static EpochManager::Participant *current = nullptr;
+  current = &self;
+
+  for (int i = 0; i < static_cast<int>(EpochManager::RECLAIM_BATCH); i++) {
+    self.Retire(new Object(i), [](void *p) {
+      delete static_cast<Object *>(p);
+      current->Retire(new Object(0));
+    });
+  }
+  for (int i = 0; i < 8; i++)
+    self.Reclaim();
+  CHECK(live_objects == start);
+}
+
+TEST_CASE("readers never observe a reclaimed object") {
+  EpochManager mgr;
+  auto start = live_objects.load();
+  std::atomic<Object *> shared{new Object(0)};
+  std::atomic<bool> stop{false};
+  std::atomic<bool> freed_seen{false};
+  std::vector<std::thread> readers;
+
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&] {
+      auto self = mgr.Register();
+      while (!stop) {
+        auto guard = self.Pin();
+        if (shared.load()->value < 0)
+          freed_seen = true;
+      }
+    });
+  }
+
+  {
+    auto self = mgr.Register();
+    for (int i = 1; i < 20'000; i++) {
+      Object *old = nullptr;
+      {
+        auto guard = self.Pin();
+        old = shared.exchange(new Object(i));
+      }
+      self.Retire(old);
+    }
+
+    stop = true;
+    for (auto &t : readers)
+      t.join();
+    for (int i = 0; i < 3; i++)
+      self.Reclaim();
+  }
+
+  CHECK_FALSE(freed_seen);
+  CHECK(mgr.CurrentEpoch() > 2);
+  delete shared.load();
+  CHECK(live_objects == start);
+}
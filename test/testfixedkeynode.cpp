@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "wbtree/detail/fixed_key_node.hpp"
+
+using namespace wbtree;
+using namespace wbtree::detail;
+
+static_assert(IS_FIXED_WIDTH_KEY<u64>);
+static_assert(IS_FIXED_WIDTH_KEY<Oid>);
+static_assert(IS_FIXED_WIDTH_KEY<KeyPair<Oid, u64>>);
+static_assert(!IS_FIXED_WIDTH_KEY<std::pair<Oid, u64>>);
+static_assert(!IS_FIXED_WIDTH_KEY<double>);
+
+TEST_CASE("BranchlessLowerBound agrees with std::lower_bound") {
+  for (usize n = 0; n < 40; n++) {
+    std::vector<int> keys;
+    for (usize i = 0; i < n; i++)
+      keys.push_back(static_cast<int>(i / 2 * 2)); // with duplicates
+
+    for (int key = -1; key <= static_cast<int>(n) + 1; key++) {
+      auto expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+      CHECK(BranchlessLowerBound(keys.data(), n, key) == static_cast<usize>(expected));
+    }
+  }
+}
+
+TEST_CASE("FixedKeyNode keeps keys sorted up to its capacity") {
+  constexpr usize PAGE_SIZE = 4096;
+  using Key = KeyPair<Oid, u64>;
+  using Node = FixedKeyNode<Key, PageNum>;
+  static_assert(Node::CAPACITY<PAGE_SIZE> == Node::Capacity(PAGE_SIZE));
+
+  alignas(16) static std::byte page[PAGE_SIZE];
+  auto node = Node::Init({page + sizeof(PageHeader), PAGE_SIZE - sizeof(PageHeader)}, PAGE_SIZE);
+  std::map<Key, PageNum> expected;
+  std::mt19937_64 rng(42);
+
+  while (true) {
+    Key key{Oid(rng() % 64), rng() % 64};
+    PageNum value(rng());
+    if (!node.Insert(key, value))
+      break;
+    expected[key] = value;
+  }
+
+  CHECK(node.IsFull());
+  REQUIRE(node.Count() == expected.size());
+  REQUIRE(node.Count() == Node::CAPACITY<PAGE_SIZE>);
+
+  usize pos = 0;
+  for (const auto &[key, value] : expected) {
+    CHECK(node.KeyAt(pos) == key);
+    CHECK(node.ValueAt(pos) == value);
+    CHECK(node.Find(key) == value);
+    pos++;
+  }
+
+  auto victim = node.KeyAt(3);
+  node.RemoveAt(3);
+  CHECK(node.Count() == expected.size() - 1);
+  CHECK_FALSE(node.Find(victim).has_value());
+}
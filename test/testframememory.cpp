@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <cstring>
+#include <doctest/doctest.h>
+
+#include "wbtree/detail/frame_memory.hpp"
+
+using namespace wbtree;
+using namespace wbtree::detail;
+
+TEST_CASE("FrameMemory partitions cover all frames, one per memory node") {
+  constexpr usize NFRAMES = 1000;
+  constexpr usize FRAME_SIZE = 8192;
+  constexpr usize DESC_SIZE = 64;
+  FrameMemory mem(NFRAMES, FRAME_SIZE, DESC_SIZE);
+  const auto &nodes = MemoryNumaNodes();
+
+  REQUIRE(!nodes.empty());
+  CHECK(std::is_sorted(nodes.begin(), nodes.end()));
+  CHECK(mem.NumPartitions() == std::min(nodes.size(), NFRAMES));
+  CHECK(mem.LocalPartition() < mem.NumPartitions());
+
+  usize next = 0;
+  for (usize part = 0; part < mem.NumPartitions(); part++) {
+    auto [first, count] = mem.PartitionFrames(part);
+    CHECK(first == next);
+    CHECK(mem.PartitionNode(part) == nodes[part]);
+    next += count;
+  }
+  CHECK(next == NFRAMES);
+
+  for (usize i = 0; i < NFRAMES; i++) {
+    std::memset(mem.Frame(i), static_cast<int>(i), FRAME_SIZE);
+    std::memset(mem.Descriptor(i), static_cast<int>(i), DESC_SIZE);
+  }
+  for (usize i = 0; i < NFRAMES; i++) {
+    CHECK(mem.Frame(i)[FRAME_SIZE - 1] == static_cast<std::byte>(i));
+    CHECK(mem.Descriptor(i)[0] == static_cast<std::byte>(i));
+  }
+}
+
+TEST_CASE("FrameMemory clock sweep stays within its partition") {
+  FrameMemory mem(10, 4096, 16);
+  auto [first, count] = mem.PartitionFrames(0);
+
+  for (usize i = 0; i < 3 * count; i++)
+    CHECK(mem.ClockTick(0) == first + i % count);
+}
@@ -0,0 +1,131 @@
+#include <atomic>
+#include <chrono>
+#include <doctest/doctest.h>
+#include <thread>
+
+#include "wbtree/detail/io_scheduler.hpp"
+
+using namespace wbtree;
+using namespace wbtree::blockio;
+
+namespace {
+using namespace std::chrono_literals;
+
+constexpr usize WRITE_SIZE = 64 * 1024;
+constexpr auto RUN_TIME = 200ms;
+
+// Device where reads and syncs take a while and writes complete at once
+struct FakeIO : IOMethods {
+  auto Open(std::string_view /*path*/, u32 /*flags*/, u32 /*mode*/) -> fd_t override {
+    return fd_t(3);
+  }
+  void Close(fd_t /*fd*/) override {}
+
+  auto Seek(fd_t /*fd*/, isize /*off*/, Whence /*whence*/) -> isize override { return 0; }
+
+  auto Write(fd_t /*fd*/, const void * /*buf*/, usize size) -> isize override {
+    return static_cast<isize>(size);
+  }
+  auto Write(fd_t /*fd*/, const void * /*buf*/, usize size, isize /*off*/) -> isize override {
+    return static_cast<isize>(size);
+  }
+  auto Read(fd_t /*fd*/, void * /*buf*/, usize size) -> isize override {
+    std::this_thread::sleep_for(2ms);
+    return static_cast<isize>(size);
+  }
+  auto Read(fd_t fd, void *buf, usize size, isize /*off*/) -> isize override {
+    return Read(fd, buf, size);
+  }
+
+  void Sync(fd_t /*fd*/) override { std::this_thread::sleep_for(2ms); }
+  void DataSync(fd_t fd) override { Sync(fd); }
+  void Truncate(fd_t /*fd*/, isize /*off*/) override {}
+};
+
+// Bytes written as CHECKPOINT during RUN_TIME, while `other` runs on another thread
+template <typename Fn> auto checkpoint_bytes(ScheduledIO &io, Fn other) -> u64 {
+  std::atomic<bool> started{false};
+  std::atomic<bool> stop{false};
+  std::thread t([&] {
+    for (; !stop; started = true)
+      other();
+  });
+  while (!started)
+    std::this_thread::yield();
+
+  IOPriorityScope prio(IOPriority::CHECKPOINT);
+  std::byte buf[1]{};
+  u64 written = 0;
+  for (auto end = std::chrono::steady_clock::now() + RUN_TIME;
+       std::chrono::steady_clock::now() < end;) {
+    written += static_cast<u64>(io.Write(fd_t(3), buf, WRITE_SIZE, 0));
+  }
+
+  stop = true;
+  t.join();
+  return written;
+}
+} // namespace
+
+TEST_CASE("checkpoint writes are throttled while foreground reads wait") {
+  FakeIO fake;
+  IOSchedulerConfig config;
+  config.checkpoint_bandwidth = 4 * 1024 * 1024;
+  ScheduledIO io(fake, config);
+  std::byte buf[1]{};
+
+  auto idle = checkpoint_bytes(io, [] { std::this_thread::sleep_for(1ms); });
+  auto contended = checkpoint_bytes(io, [&] { (void)io.Read(fd_t(3), buf, 1, 0); });
+
+  // 4 MiB/s over RUN_TIME, with slack for the burst and timing noise
+  CHECK(contended <= 4 * 1024 * 1024);
+  CHECK(idle > 10 * contended);
+}
+
+TEST_CASE("untagged writes and syncs do not throttle the background") {
+  FakeIO fake;
+  IOSchedulerConfig config;
+  config.checkpoint_bandwidth = 4 * 1024 * 1024;
+  ScheduledIO io(fake, config);
+  std::byte buf[1]{};
+
+  auto written = checkpoint_bytes(io, [&] {
+    (void)io.Write(fd_t(3), buf, 1, 0);
+    io.DataSync(fd_t(3));
+  });
+
+  CHECK(written > 16 * 1024 * 1024);
+}
+
+TEST_CASE("background reads get their bandwidth while foreground reads wait") {
+  FakeIO fake;
+  IOSchedulerConfig config;
+  config.background_read_queue_depth = 1;
+  // Less than a byte per refill window
+  config.background_read_bandwidth = 50;
+  ScheduledIO io(fake, config);
+  std::byte buf[1]{};
+  std::atomic<bool> stop{false};
+  std::atomic<u64> reads{0};
+
+  std::thread bg([&] {
+    IOPriorityScope prio(IOPriority::BACKGROUND_READ);
+    while (!stop) {
+      (void)io.Read(fd_t(3), buf, 1, 0);
+      reads++;
+    }
+  });
+
+  (void)io.Read(fd_t(3), buf, 1, 0);
+  auto before = reads.load();
+  auto end = std::chrono::steady_clock::now() + 500ms;
+  while (std::chrono::steady_clock::now() < end)
+    (void)io.Read(fd_t(3), buf, 1, 0);
+  auto throttled = reads.load() - before;
+  stop = true;
+  bg.join();
+
+  // 25 one byte reads at 50 B/s, with slack for timing noise. Unthrottled, 250 would get through.
+  CHECK(throttled >= 12);
+  CHECK(throttled <= 40);
+}
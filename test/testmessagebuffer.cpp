@@ -0,0 +1,76 @@
+#include <doctest/doctest.h>
+#include <string>
+#include <vector>
+
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/message_buffer.hpp"
+
+using namespace wbtree;
+using namespace wbtree::detail;
+
+namespace {
+auto bytes(const std::string &s) -> gsl::span<const std::byte> {
+  return {reinterpret_cast<const std::byte *>(s.data()), s.size()};
+}
+} // namespace
+
+TEST_CASE("MessageBuffer delivers messages in key order, stable per key") {
+  std::vector<std::byte> region(256);
+  auto buf = MessageBuffer::Init(region);
+  std::string a = "a", b = "b", v1 = "v1", v2 = "v2";
+
+  REQUIRE(buf.Append({MessageKind::INSERT, bytes(b), bytes(v1)}));
+  REQUIRE(buf.Append({MessageKind::INSERT, bytes(a), bytes(v1)}));
+  REQUIRE(buf.Append({MessageKind::UPDATE, bytes(b), bytes(v2)}));
+  REQUIRE(buf.Append({MessageKind::DELETE, bytes(a), bytes(v2)}));
+  CHECK(buf.Count() == 4);
+
+  std::vector<std::pair<char, MessageKind>> seen;
+  buf.ForEachSorted([&](const Message &msg) {
+    seen.emplace_back(static_cast<char>(msg.key[0]), msg.kind);
+  });
+
+  std::vector<std::pair<char, MessageKind>> expected = {{'a', MessageKind::INSERT},
+                                                        {'a', MessageKind::DELETE},
+                                                        {'b', MessageKind::INSERT},
+                                                        {'b', MessageKind::UPDATE}};
+  CHECK(seen == expected);
+}
+
+TEST_CASE("MessageBuffer lookup returns the latest message for a key") {
+  std::vector<std::byte> region(256);
+  auto buf = MessageBuffer::Init(region);
+  std::string k = "key", other = "other", v1 = "v1", v2 = "v2";
+
+  CHECK_FALSE(buf.Lookup(bytes(k)).has_value());
+
+  REQUIRE(buf.Append({MessageKind::INSERT, bytes(k), bytes(v1)}));
+  REQUIRE(buf.Append({MessageKind::UPDATE, bytes(k), bytes(v2)}));
+  auto msg = buf.Lookup(bytes(k));
+  REQUIRE(msg.has_value());
+  CHECK(msg->kind == MessageKind::UPDATE);
+  CHECK(std::string(reinterpret_cast<const char *>(msg->value.data()), msg->value.size()) == v2);
+
+  REQUIRE(buf.Append({MessageKind::DELETE, bytes(k), bytes(v2)}));
+  msg = buf.Lookup(bytes(k));
+  REQUIRE(msg.has_value());
+  CHECK(msg->kind == MessageKind::DELETE);
+  CHECK(msg->value.empty());
+  CHECK_FALSE(buf.Lookup(bytes(other)).has_value());
+}
+
+TEST_CASE("MessageBuffer reports when it must be flushed") {
+  std::vector<std::byte> region(64);
+  auto buf = MessageBuffer::Init(region);
+  std::string k = "k", v(16, 'x'), big(128, 'x');
+
+  while (buf.Append({MessageKind::INSERT, bytes(k), bytes(v)}))
+    ;
+  CHECK(buf.Count() > 0);
+  CHECK_FALSE(buf.Fits(bytes(k), bytes(v)));
+  CHECK_THROWS_AS(buf.Append({MessageKind::INSERT, bytes(k), bytes(big)}), error::ElementTooBig);
+
+  buf.Clear();
+  CHECK(buf.Count() == 0);
+  CHECK(buf.Append({MessageKind::INSERT, bytes(k), bytes(v)}));
+}
@@ -0,0 +1,66 @@
+#include <doctest/doctest.h>
+#include <vector>
+
+#include "wbtree/detail/control_data.hpp"
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/overflow.hpp"
+#include "wbtree/detail/page.hpp"
+
+#include "testrelation.hpp"
+
+using namespace wbtree;
+using namespace wbtree::blockio;
+using namespace wbtree::detail;
+
+namespace {
+constexpr usize PAGE_SIZE = 512;
+
+auto read_all(OverflowReader &reader, usize step) -> std::vector<std::byte> {
+  std::vector<std::byte> out;
+  std::vector<std::byte> buf(step);
+
+  while (auto n = reader.Read(buf))
+    out.insert(out.end(), buf.begin(), buf.begin() + static_cast<isize>(n));
+  return out;
+}
+} // namespace
+
+TEST_CASE("overflow values round trip through a streaming reader") {
+  test::TempFile tmp("overflow");
+  SystemIO io;
+  auto file = OpenWith(io, tmp.path.c_str(), OpenFlags::WRITE | OpenFlags::CREAT | OpenFlags::TRUNC,
+                       CreateMode::USR_READ | CreateMode::USR_WRITE);
+  auto rfile = OpenWith(io, tmp.path.c_str(), OpenFlags::READ);
+
+  std::vector<std::byte> value(10'000);
+  for (usize i = 0; i < value.size(); i++)
+    value[i] = static_cast<std::byte>(i * 7);
+
+  CHECK(ControlData(PAGE_SIZE).MaxInlineValueSize() == PAGE_SIZE / 4);
+
+  auto ref = WriteOverflow(file, PAGE_SIZE, PageNum(3), LogSeqNum(5), value);
+  CHECK(ref.first == PageNum(3));
+  CHECK(ref.length == value.size());
+
+  OverflowReader reader(rfile, PAGE_SIZE, ref);
+  CHECK(read_all(reader, 333) == value);
+  CHECK(reader.Remaining() == 0);
+
+  // damage the second page of the chain
+  test::DamagePage(tmp.path, PageNum(4), PAGE_SIZE);
+  OverflowReader damaged(rfile, PAGE_SIZE, ref);
+  CHECK_THROWS_AS(read_all(damaged, 333), error::CorruptPage);
+}
+
+TEST_CASE("empty overflow value occupies one page") {
+  test::TempFile tmp("overflow_empty");
+  SystemIO io;
+  auto file = OpenWith(io, tmp.path.c_str(), OpenFlags::WRITE | OpenFlags::CREAT | OpenFlags::TRUNC,
+                       CreateMode::USR_READ | CreateMode::USR_WRITE);
+  auto rfile = OpenWith(io, tmp.path.c_str(), OpenFlags::READ);
+
+  CHECK(OverflowPageCount(PAGE_SIZE, 0) == 1);
+  auto ref = WriteOverflow(file, PAGE_SIZE, PageNum(0), LogSeqNum(1), {});
+  OverflowReader reader(rfile, PAGE_SIZE, ref);
+  CHECK(read_all(reader, 16).empty());
+}
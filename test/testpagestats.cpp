@@ -0,0 +1,108 @@
+#include <doctest/doctest.h>
+#include <vector>
+
+#include "wbtree/detail/page.hpp"
+#include "wbtree/detail/page_scan.hpp"
+#include "wbtree/detail/page_stats.hpp"
+
+#include "testrelation.hpp"
+
+using namespace wbtree;
+using namespace wbtree::blockio;
+using namespace wbtree::detail;
+
+namespace {
+constexpr usize PAGE_SIZE = 4096;
+// Spans several SCAN_READ_SIZE chunks, so that all workers get some
+constexpr usize NPAGES = 3 * SCAN_READ_SIZE / PAGE_SIZE + 10;
+
+// Leaves, every tenth of which is half full and out of order, under an inner page every 100 pages,
+// with every 50th page free and the last page overflow
+auto make_page(usize i) -> std::vector<std::byte> {
+  std::vector<std::byte> page(PAGE_SIZE);
+  PageHeader hdr{LogSeqNum(1), 0, PageKind::LEAF, 0, 0, 0, 0, PageNum(i + 1)};
+
+  if (i == NPAGES - 1) {
+    hdr.kind = PageKind::OVERFLOW;
+  } else if (i % 100 == 0) {
+    hdr.kind = PageKind::INNER;
+    hdr.level = 1;
+    hdr.used = static_cast<u32>(PagePayloadSize(PAGE_SIZE));
+  } else if (i % 50 == 0) {
+    hdr.kind = PageKind::FREE;
+  } else if (i % 10 == 0) {
+    hdr.used = static_cast<u32>(PagePayloadSize(PAGE_SIZE) / 2);
+    hdr.next = PageNum(i + 2);
+  } else {
+    hdr.used = static_cast<u32>(PagePayloadSize(PAGE_SIZE));
+  }
+
+  WritePageHeader(page, hdr);
+  SetPageChecksum(page);
+  return page;
+}
+
+struct Relation : test::Relation {
+  Relation() : test::Relation("page_stats", PAGE_SIZE, NPAGES, make_page) {}
+};
+
+void check_same(const RelationStats &a, const RelationStats &b) {
+  CHECK(a.pages == b.pages);
+  CHECK(a.free_pages == b.free_pages);
+  CHECK(a.overflow_pages == b.overflow_pages);
+  CHECK(a.leaves_out_of_order == b.leaves_out_of_order);
+  CHECK(a.corrupt_pages == b.corrupt_pages);
+  REQUIRE(a.Height() == b.Height());
+  for (usize i = 0; i < a.Height(); i++) {
+    CHECK(a.levels[i].pages == b.levels[i].pages);
+    CHECK(a.levels[i].used_bytes == b.levels[i].used_bytes);
+    CHECK(a.levels[i].fill_histogram == b.levels[i].fill_histogram);
+  }
+}
+} // namespace
+
+TEST_CASE("relation stats count pages by kind and level") {
+  Relation rel;
+  SystemIO io;
+
+  auto stats = AnalyzeRelation(io, rel.path, PAGE_SIZE, 1);
+  usize inner = (NPAGES + 99) / 100;
+  usize free = NPAGES / 50 - NPAGES / 100;
+  usize half = NPAGES / 10 - NPAGES / 50;
+  usize leaves = NPAGES - inner - free - 1;
+
+  CHECK(stats.pages == NPAGES);
+  CHECK(stats.free_pages == free);
+  CHECK(stats.overflow_pages == 1);
+  CHECK(stats.corrupt_pages.empty());
+  REQUIRE(stats.Height() == 2);
+  CHECK(stats.levels[0].pages == leaves);
+  CHECK(stats.levels[1].pages == inner);
+  CHECK(stats.levels[0].fill_histogram[FILL_BUCKETS / 2] == half);
+  CHECK(stats.levels[0].fill_histogram[FILL_BUCKETS - 1] == leaves - half);
+  CHECK(stats.FillFactor(1, PAGE_SIZE) == 1.0);
+  CHECK(stats.leaves_out_of_order == half);
+  CHECK(stats.Fragmentation() == static_cast<double>(half) / static_cast<double>(leaves));
+}
+
+TEST_CASE("relation stats do not depend on the number of workers") {
+  Relation rel;
+  rel.Damage(PageNum(7));
+  SystemIO io;
+
+  auto single = AnalyzeRelation(io, rel.path, PAGE_SIZE, 1);
+  for (usize nworkers : {2, 4, 16})
+    check_same(AnalyzeRelation(io, rel.path, PAGE_SIZE, nworkers), single);
+}
+
+TEST_CASE("corrupt pages are reported instead of thrown") {
+  Relation rel;
+  rel.Damage(PageNum(3));
+  rel.Damage(PageNum(NPAGES - 2));
+  SystemIO io;
+
+  auto stats = AnalyzeRelation(io, rel.path, PAGE_SIZE, 3);
+  std::vector<PageNum> corrupt{PageNum(3), PageNum(NPAGES - 2)};
+  CHECK(stats.pages == NPAGES);
+  CHECK(stats.corrupt_pages == corrupt);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <fmt/format.h>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+#include "wbtree/detail/blockio.hpp"
+#include "wbtree/detail/page.hpp"
+
+namespace wbtree::test {
+// Path in the temp directory, unique to this process and call, so that concurrent test runs do not
+// share files
+inline auto TempPath(std::string_view name) -> std::filesystem::path {
+  static std::atomic<u64> seq{0};
+  return std::filesystem::temp_directory_path() /
+         fmt::format("wbtree_test_{}_{}_{}", name, ::getpid(), seq++);
+}
+
+// Overwrites a byte in the payload of page `pageno`, so that it fails verification
+inline void DamagePage(const std::filesystem::path &path, PageNum pageno, usize page_size) {
+  blockio::SystemIO io;
+  auto file = blockio::OpenWith(io, path.c_str(), blockio::OpenFlags::WRITE);
+  auto garbage = std::byte{0x5a};
+  REQUIRE(file.Write(&garbage, 1, detail::PageOffset(pageno, page_size) + 100) == 1);
+}
+
+// File at a TempPath(), removed on destruction
+struct TempFile {
+  explicit TempFile(std::string_view name) : path(TempPath(name)) {}
+  ~TempFile() { std::filesystem::remove(path); }
+
+  TempFile(const TempFile &) = delete;
+  TempFile(TempFile &&) = delete;
+  auto operator=(const TempFile &) -> TempFile & = delete;
+  auto operator=(TempFile &&) -> TempFile & = delete;
+
+  std::filesystem::path path;
+};
+
+// Relation file of `npages` pages, whose page i is `make_page(i)`
+struct Relation : TempFile {
+  template <typename MakePage>
+  Relation(std::string_view name, usize page_size, usize npages, MakePage make_page)
+      : TempFile(name), m_page_size(page_size) {
+    blockio::SystemIO io;
+    auto file = blockio::OpenWith(
+        io, path.c_str(),
+        blockio::OpenFlags::WRITE | blockio::OpenFlags::CREAT | blockio::OpenFlags::TRUNC,
+        blockio::CreateMode::USR_READ | blockio::CreateMode::USR_WRITE);
+
+    for (usize i = 0; i < npages; i++) {
+      std::vector<std::byte> page = make_page(i);
+      REQUIRE(page.size() == page_size);
+      auto off = detail::PageOffset(PageNum(i), page_size);
+      REQUIRE(file.Write(page.data(), page_size, off) == static_cast<isize>(page_size));
+    }
+  }
+
+  void Damage(PageNum pageno) const { DamagePage(path, pageno, m_page_size); }
+
+private:
+  usize m_page_size;
+};
+} // namespace wbtree::test
@@ -0,0 +1,41 @@
+#include <doctest/doctest.h>
+
+#include "wbtree/detail/errors.hpp"
+#include "wbtree/detail/swizzle.hpp"
+
+using namespace wbtree;
+using namespace wbtree::detail;
+
+namespace {
+struct Frame {
+  int id;
+};
+} // namespace
+
+TEST_CASE("SwizzledPtr swaps between page number and frame pointer") {
+  Frame frame{7};
+  SwizzledPtr<Frame> ptr(PageNum(42));
+
+  CHECK_FALSE(ptr.Load().IsSwizzled());
+  CHECK(ptr.Load().AsPageNum() == PageNum(42));
+
+  CHECK_FALSE(ptr.Swizzle(PageNum(41), &frame));
+  CHECK(ptr.Swizzle(PageNum(42), &frame));
+  REQUIRE(ptr.Load().IsSwizzled());
+  CHECK(ptr.Load().AsFrame()->id == 7);
+
+  CHECK_FALSE(ptr.Unswizzle(nullptr, PageNum(42)));
+  CHECK(ptr.Unswizzle(&frame, PageNum(42)));
+  CHECK(ptr.Load().AsPageNum() == PageNum(42));
+}
+
+TEST_CASE("SwizzledPtr has a single encoding for no page") {
+  SwizzledPtr<Frame> none;
+  SwizzledPtr<Frame> invalid(INVALID_PAGE);
+
+  CHECK_FALSE(none.Load().IsSwizzled());
+  CHECK_FALSE(invalid.Load().IsSwizzled());
+  CHECK(none.Load().AsPageNum() == INVALID_PAGE);
+  CHECK(invalid.Load().AsPageNum() == INVALID_PAGE);
+  CHECK_THROWS_AS(SwizzledPtr<Frame>(INVALID_PAGE + PageNum(1)), error::CorruptPage);
+}
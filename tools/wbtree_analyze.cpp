@@ -0,0 +1,65 @@
+// Prints the page statistics of a relation file, as gathered by AnalyzeRelation()
+//
+//   wbtree_analyze <relation file> <page size> [workers]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fmt/format.h>
+#include <string>
+#include <thread>
+
+#include "wbtree/detail/page.hpp"
+#include "wbtree/detail/page_stats.hpp"
+
+using namespace wbtree;
+using namespace wbtree::detail;
+
+namespace {
+void print_report(const RelationStats &stats, usize page_size) {
+  fmt::print("pages:            {}\n", stats.pages);
+  fmt::print("free pages:       {}\n", stats.free_pages);
+  fmt::print("overflow pages:   {}\n", stats.overflow_pages);
+  fmt::print("height:           {}\n", stats.Height());
+
+  for (usize level = 0; level < stats.Height(); level++) {
+    const auto &lvl = stats.levels[level];
+    fmt::print("level {}:          {} pages, {:.1f}% full\n", level, lvl.pages,
+               100 * stats.FillFactor(level, page_size));
+    for (usize b = 0; b < FILL_BUCKETS; b++) {
+      fmt::print("  {:3}-{:3}%: {}\n", b * 100 / FILL_BUCKETS, (b + 1) * 100 / FILL_BUCKETS,
+                 lvl.fill_histogram[b]);
+    }
+  }
+
+  fmt::print("fragmentation:    {:.1f}% of leaves out of order\n", 100 * stats.Fragmentation());
+  fmt::print("corrupt pages:    {}\n", stats.corrupt_pages.size());
+  for (auto pageno : stats.corrupt_pages)
+    fmt::print("  {}\n", pageno.get());
+}
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+  if (argc < 3 || argc > 4) {
+    fmt::print(stderr, "usage: {} <relation file> <page size> [workers]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto page_size = static_cast<usize>(std::stoull(argv[2]));
+    if (page_size <= sizeof(PageHeader)) {
+      fmt::print(stderr, "{}: page size {} is too small\n", argv[0], page_size);
+      return EXIT_FAILURE;
+    }
+    auto nworkers = argc == 4 ? static_cast<usize>(std::stoull(argv[3]))
+                              : std::max(std::thread::hardware_concurrency(), 1U);
+    blockio::SystemIO io;
+
+    print_report(AnalyzeRelation(io, argv[1], page_size, nworkers), page_size);
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}: {}\n", argv[0], e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}